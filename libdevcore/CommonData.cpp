@@ -24,6 +24,10 @@
 
 #include "Exceptions.h"
 
+#if ETH_SIMD_X86
+#include <immintrin.h>
+#endif
+
 using namespace std;
 using namespace dev;
 
@@ -41,12 +45,279 @@ int fromHexChar(char _i) noexcept
 }
 }
 
+namespace
+{
+char const c_hexDigits[] = "0123456789abcdef";
+
+void hexEncodeScalar(byte const* _data, size_t _size, char* o_hex)
+{
+	for (size_t i = 0; i < _size; ++i)
+	{
+		*o_hex++ = c_hexDigits[_data[i] >> 4];
+		*o_hex++ = c_hexDigits[_data[i] & 0x0f];
+	}
+}
+
+bool hexDecodeScalar(char const* _hex, size_t _size, byte* o_data)
+{
+	for (size_t i = 0; i < _size; i += 2)
+	{
+		int h = fromHexChar(_hex[i]);
+		int l = fromHexChar(_hex[i + 1]);
+		if (h == -1 || l == -1)
+			return false;
+		*o_data++ = (byte)(h * 16 + l);
+	}
+	return true;
+}
+
+bool isHexDigitsScalar(char const* _hex, size_t _size)
+{
+	return std::all_of(_hex, _hex + _size, [](char c){ return fromHexChar(c) != -1; });
+}
+
+#if ETH_SIMD_X86
+
+/******** SSE4 and AVX2 kernels, the scalar ones process the tail ********/
+
+// Nibble values of 16 characters, false in o_valid lanes that are not hex digits.
+// Digits are checked on the character, letters on the character with the lower case bit set.
+#define HEX_NIBBLES(PREFIX, SUFFIX, V, c, o_valid)                                                 \
+	V const lower = PREFIX##or_##SUFFIX(c, PREFIX##set1_epi8(0x20));                                \
+	V const isDigit = PREFIX##and_##SUFFIX(PREFIX##cmpgt_epi8(c, PREFIX##set1_epi8('0' - 1)),       \
+		PREFIX##cmpgt_epi8(PREFIX##set1_epi8('9' + 1), c));                                         \
+	V const isLetter = PREFIX##and_##SUFFIX(PREFIX##cmpgt_epi8(lower, PREFIX##set1_epi8('a' - 1)), \
+		PREFIX##cmpgt_epi8(PREFIX##set1_epi8('f' + 1), lower));                                     \
+	o_valid = PREFIX##or_##SUFFIX(isDigit, isLetter);                                               \
+	V const nibbles = PREFIX##blendv_epi8(PREFIX##sub_epi8(lower, PREFIX##set1_epi8('a' - 10)),     \
+		PREFIX##sub_epi8(c, PREFIX##set1_epi8('0')), isDigit);
+
+__attribute__((target("sse4.1")))
+size_t hexEncodeSSE4(byte const* _data, size_t _size, char* o_hex)
+{
+	__m128i const digits = _mm_loadu_si128(reinterpret_cast<__m128i const*>(c_hexDigits));
+	__m128i const mask = _mm_set1_epi8(0x0f);
+	size_t i = 0;
+	for (; i + 16 <= _size; i += 16)
+	{
+		__m128i const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(_data + i));
+		__m128i const hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(v, 4), mask));
+		__m128i const lo = _mm_shuffle_epi8(digits, _mm_and_si128(v, mask));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(o_hex + 2 * i), _mm_unpacklo_epi8(hi, lo));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(o_hex + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+	}
+	return i;
+}
+
+__attribute__((target("avx2")))
+size_t hexEncodeAVX2(byte const* _data, size_t _size, char* o_hex)
+{
+	__m256i const digits = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const*>(c_hexDigits)));
+	__m256i const mask = _mm256_set1_epi8(0x0f);
+	size_t i = 0;
+	for (; i + 32 <= _size; i += 32)
+	{
+		__m256i const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(_data + i));
+		__m256i const hi = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(v, 4), mask));
+		__m256i const lo = _mm256_shuffle_epi8(digits, _mm256_and_si256(v, mask));
+		// unpack works within 128 bit lanes
+		__m256i const a = _mm256_unpacklo_epi8(hi, lo);
+		__m256i const b = _mm256_unpackhi_epi8(hi, lo);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(o_hex + 2 * i), _mm256_permute2x128_si256(a, b, 0x20));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(o_hex + 2 * i + 32), _mm256_permute2x128_si256(a, b, 0x31));
+	}
+	return i;
+}
+
+// The kernels return the number of characters processed, or -1 on a bad character
+__attribute__((target("sse4.1")))
+ptrdiff_t hexDecodeSSE4(char const* _hex, size_t _size, byte* o_data)
+{
+	// high nibble * 16 + low nibble of each character pair
+	__m128i const weights = _mm_set1_epi16(0x0110);
+	size_t i = 0;
+	for (; i + 32 <= _size; i += 32)
+	{
+		__m128i pairs[2];
+		for (size_t j = 0; j < 2; ++j)
+		{
+			__m128i const c = _mm_loadu_si128(reinterpret_cast<__m128i const*>(_hex + i + 16 * j));
+			__m128i valid;
+			HEX_NIBBLES(_mm_, si128, __m128i, c, valid)
+			if (_mm_movemask_epi8(valid) != 0xffff)
+				return -1;
+			pairs[j] = _mm_maddubs_epi16(nibbles, weights);
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(o_data + i / 2), _mm_packus_epi16(pairs[0], pairs[1]));
+	}
+	return i;
+}
+
+__attribute__((target("avx2")))
+ptrdiff_t hexDecodeAVX2(char const* _hex, size_t _size, byte* o_data)
+{
+	__m256i const weights = _mm256_set1_epi16(0x0110);
+	size_t i = 0;
+	for (; i + 64 <= _size; i += 64)
+	{
+		__m256i pairs[2];
+		for (size_t j = 0; j < 2; ++j)
+		{
+			__m256i const c = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(_hex + i + 32 * j));
+			__m256i valid;
+			HEX_NIBBLES(_mm256_, si256, __m256i, c, valid)
+			if (_mm256_movemask_epi8(valid) != -1)
+				return -1;
+			pairs[j] = _mm256_maddubs_epi16(nibbles, weights);
+		}
+		// pack works within 128 bit lanes
+		__m256i const packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(pairs[0], pairs[1]), 0xd8);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(o_data + i / 2), packed);
+	}
+	return i;
+}
+
+__attribute__((target("sse4.1")))
+ptrdiff_t isHexDigitsSSE4(char const* _hex, size_t _size)
+{
+	size_t i = 0;
+	for (; i + 16 <= _size; i += 16)
+	{
+		__m128i const c = _mm_loadu_si128(reinterpret_cast<__m128i const*>(_hex + i));
+		__m128i valid;
+		HEX_NIBBLES(_mm_, si128, __m128i, c, valid)
+		(void)nibbles;
+		if (_mm_movemask_epi8(valid) != 0xffff)
+			return -1;
+	}
+	return i;
+}
+
+__attribute__((target("avx2")))
+ptrdiff_t isHexDigitsAVX2(char const* _hex, size_t _size)
+{
+	size_t i = 0;
+	for (; i + 32 <= _size; i += 32)
+	{
+		__m256i const c = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(_hex + i));
+		__m256i valid;
+		HEX_NIBBLES(_mm256_, si256, __m256i, c, valid)
+		(void)nibbles;
+		if (_mm256_movemask_epi8(valid) != -1)
+			return -1;
+	}
+	return i;
+}
+
+#endif  // ETH_SIMD_X86
+}
+
+namespace
+{
+SimdKernel hexKernel()
+{
+	static SimdKernel const kernel = fastestSimdKernel({SimdKernel::AVX2, SimdKernel::SSE4});
+	return kernel;
+}
+}
+
+void dev::hexEncode(byte const* _data, size_t _size, char* o_hex)
+{
+	hexEncode(_data, _size, o_hex, hexKernel());
+}
+
+void dev::hexEncode(byte const* _data, size_t _size, char* o_hex, SimdKernel _kernel)
+{
+	size_t done = 0;
+#if ETH_SIMD_X86
+	if (_kernel >= SimdKernel::AVX2 && simdKernelSupported(SimdKernel::AVX2))
+		done = hexEncodeAVX2(_data, _size, o_hex);
+	if (_kernel >= SimdKernel::SSE4 && simdKernelSupported(SimdKernel::SSE4))
+		done += hexEncodeSSE4(_data + done, _size - done, o_hex + 2 * done);
+#else
+	(void)_kernel;
+#endif
+	hexEncodeScalar(_data + done, _size - done, o_hex + 2 * done);
+}
+
+bool dev::hexDecode(char const* _hex, size_t _size, byte* o_data)
+{
+	return hexDecode(_hex, _size, o_data, hexKernel());
+}
+
+bool dev::hexDecode(char const* _hex, size_t _size, byte* o_data, SimdKernel _kernel)
+{
+	size_t done = 0;
+#if ETH_SIMD_X86
+	ptrdiff_t processed = 0;
+	if (_kernel >= SimdKernel::AVX2 && simdKernelSupported(SimdKernel::AVX2))
+	{
+		if ((processed = hexDecodeAVX2(_hex, _size, o_data)) == -1)
+			return false;
+		done = processed;
+	}
+	if (_kernel >= SimdKernel::SSE4 && simdKernelSupported(SimdKernel::SSE4))
+	{
+		if ((processed = hexDecodeSSE4(_hex + done, _size - done, o_data + done / 2)) == -1)
+			return false;
+		done += processed;
+	}
+#else
+	(void)_kernel;
+#endif
+	return hexDecodeScalar(_hex + done, _size - done, o_data + done / 2);
+}
+
+bool dev::isHexDigits(char const* _hex, size_t _size)
+{
+	return isHexDigits(_hex, _size, hexKernel());
+}
+
+bool dev::isHexDigits(char const* _hex, size_t _size, SimdKernel _kernel)
+{
+	size_t done = 0;
+#if ETH_SIMD_X86
+	ptrdiff_t processed = 0;
+	if (_kernel >= SimdKernel::AVX2 && simdKernelSupported(SimdKernel::AVX2))
+	{
+		if ((processed = isHexDigitsAVX2(_hex, _size)) == -1)
+			return false;
+		done = processed;
+	}
+	if (_kernel >= SimdKernel::SSE4 && simdKernelSupported(SimdKernel::SSE4))
+	{
+		if ((processed = isHexDigitsSSE4(_hex + done, _size - done)) == -1)
+			return false;
+		done += processed;
+	}
+#else
+	(void)_kernel;
+#endif
+	return isHexDigitsScalar(_hex + done, _size - done);
+}
+
 bool dev::isHex(string const& _s) noexcept
 {
-	auto it = _s.begin();
-	if (_s.compare(0, 2, "0x") == 0)
-		it += 2;
-	return std::all_of(it, _s.end(), [](char c){ return fromHexChar(c) != -1; });
+	size_t const s = _s.compare(0, 2, "0x") == 0 ? 2 : 0;
+	return isHexDigits(_s.data() + s, _s.size() - s);
+}
+
+void dev::toLowerCase(std::string& io_s) noexcept
+{
+	// branch free, so that the compiler vectorizes the loop
+	for (char& c : io_s)
+		c |= (c >= 'A' && c <= 'Z') ? 0x20 : 0;
+}
+
+void dev::removeLeadingHexZeros(std::string& io_hex) noexcept
+{
+	if (io_hex.size() < 4 || io_hex.compare(0, 2, "0x") != 0)
+		return;
+	size_t const end = io_hex.size() - 1;
+	size_t digit = 2;
+	while (digit < end && io_hex[digit] == '0')
+		++digit;
+	io_hex.erase(2, digit - 2);
 }
 
 std::string dev::escaped(std::string const& _s, bool _all)
@@ -81,34 +352,24 @@ std::string dev::escaped(std::string const& _s, bool _all)
 bytes dev::fromHex(std::string const& _s, WhenError _throw)
 {
 	unsigned s = (_s.size() >= 2 && _s[0] == '0' && _s[1] == 'x') ? 2 : 0;
-	std::vector<uint8_t> ret;
-	ret.reserve((_s.size() - s + 1) / 2);
+	std::vector<uint8_t> ret((_s.size() - s + 1) / 2);
 
+	bool valid = true;
 	if (_s.size() % 2)
 	{
 		int h = fromHexChar(_s[s++]);
-		if (h != -1)
-			ret.push_back(h);
-		else if (_throw == WhenError::Throw)
-			BOOST_THROW_EXCEPTION(BadHexCharacter());
-		else
-			return bytes();
-	}
-	for (unsigned i = s; i < _s.size(); i += 2)
-	{
-		int h = fromHexChar(_s[i]);
-		int l = fromHexChar(_s[i + 1]);
-		if (h != -1 && l != -1)
-			ret.push_back((byte)(h * 16 + l));
-		else if (_throw == WhenError::Throw)
-			BOOST_THROW_EXCEPTION(BadHexCharacter());
-		else
-			return bytes();
+		valid = h != -1;
+		if (valid)
+			ret[0] = h;
 	}
-	return ret;
+	if (valid && hexDecode(_s.data() + s, _s.size() - s, ret.data() + _s.size() % 2))
+		return ret;
+	if (_throw == WhenError::Throw)
+		BOOST_THROW_EXCEPTION(BadHexCharacter());
+	return bytes();
 }
 
-/*bytes dev::asNibbles(bytesConstRef const& _s)
+bytes dev::asNibbles(bytesConstRef const& _s)
 {
 	std::vector<uint8_t> ret;
 	ret.reserve(_s.size() * 2);
@@ -118,7 +379,7 @@ bytes dev::fromHex(std::string const& _s, WhenError _throw)
 		ret.push_back(i % 16);
 	}
 	return ret;
-}*/
+}
 
 std::string dev::toString(string32 const& _s)
 {
@@ -30,6 +30,7 @@
 #include <cstring>
 #include <string>
 #include "Common.h"
+#include "CpuFeatures.h"
 
 namespace dev
 {
@@ -42,21 +43,57 @@ enum class WhenError
 	Throw = 1,
 };
 
+/// The hex kernels process 16 bytes at once with SSE4, 32 with AVX2 and AVX512.
+/// The functions without a kernel use the fastest one supported by the CPU.
+
+/// Writes 2 * @a _size lower case hex digits of @a _data to @a o_hex.
+void hexEncode(byte const* _data, size_t _size, char* o_hex);
+void hexEncode(byte const* _data, size_t _size, char* o_hex, SimdKernel _kernel);
+
+/// Decodes an even number @a _size of hex digits of either case into @a _size / 2 bytes.
+/// @returns false if one of the characters is not a hex digit, @a o_data is then undefined.
+bool hexDecode(char const* _hex, size_t _size, byte* o_data);
+bool hexDecode(char const* _hex, size_t _size, byte* o_data, SimdKernel _kernel);
+
+/// @returns true if all @a _size characters are hex digits.
+bool isHexDigits(char const* _hex, size_t _size);
+bool isHexDigits(char const* _hex, size_t _size, SimdKernel _kernel);
+
+/// Iterators of contiguous memory are encoded with hexEncode.
+template <class Iterator>
+struct isContiguousIterator: std::integral_constant<bool, std::is_pointer<Iterator>::value ||
+	std::is_same<Iterator, bytes::iterator>::value || std::is_same<Iterator, bytes::const_iterator>::value ||
+	std::is_same<Iterator, std::string::iterator>::value || std::is_same<Iterator, std::string::const_iterator>::value>
+{};
+
+template <class Iterator>
+void toHex(Iterator _it, Iterator _end, char* o_hex, std::true_type)
+{
+	if (_it != _end)
+		hexEncode(reinterpret_cast<byte const*>(&*_it), std::distance(_it, _end), o_hex);
+}
+
+template <class Iterator>
+void toHex(Iterator _it, Iterator _end, char* o_hex, std::false_type)
+{
+	static char const* hexdigits = "0123456789abcdef";
+	for (; _it != _end; _it++)
+	{
+		*o_hex++ = hexdigits[(*_it >> 4) & 0x0f];
+		*o_hex++ = hexdigits[*_it & 0x0f];
+	}
+}
+
 template <class Iterator>
 std::string toHex(Iterator _it, Iterator _end, std::string const& _prefix)
 {
 	typedef std::iterator_traits<Iterator> traits;
 	static_assert(sizeof(typename traits::value_type) == 1, "toHex needs byte-sized element type");
 
-	static char const* hexdigits = "0123456789abcdef";
 	size_t off = _prefix.size();
 	std::string hex(std::distance(_it, _end)*2 + off, '0');
 	hex.replace(0, off, _prefix);
-	for (; _it != _end; _it++)
-	{
-		hex[off++] = hexdigits[(*_it >> 4) & 0x0f];
-		hex[off++] = hexdigits[*_it & 0x0f];
-	}
+	toHex(_it, _end, &hex[off], isContiguousIterator<Iterator>());
 	return hex;
 }
 
@@ -82,6 +119,13 @@ bytes fromHex(std::string const& _s, WhenError _throw = WhenError::DontThrow);
 /// @returns true if @a _s is a hex string.
 bool isHex(std::string const& _s) noexcept;
 
+/// Converts ASCII letters of @a io_s to lower case in place.
+void toLowerCase(std::string& io_s) noexcept;
+
+/// Removes leading zeros of a 0x prefixed hex value in place, leaving at least one digit.
+/// @example "0x0004" -> "0x4", "0x00" -> "0x0"
+void removeLeadingHexZeros(std::string& io_hex) noexcept;
+
 /// @returns true if @a _hash is a hash conforming to FixedHash type @a T.
 template <class T> static bool isHash(std::string const& _hash)
 {
@@ -126,10 +126,18 @@ void writeFile(boost::filesystem::path const& _file, bytesConstRef _data, bool _
 {
 	if (_writeDeleteRename)
 	{
-		fs::path tempPath = appendToFilename(_file, "-%%%%%%"); // XXX should not convert to string for this
-		writeFile(tempPath, _data, false);
-		// will delete _file if it exists
-		fs::rename(tempPath, _file);
+		fs::path tempPath = uniqueTempPath(_file);
+		try
+		{
+			writeFile(tempPath, _data, false);
+			// will delete _file if it exists
+			fs::rename(tempPath, _file);
+		}
+		catch (...)
+		{
+			DEV_IGNORE_EXCEPTIONS(fs::remove(tempPath));
+			throw;
+		}
 	}
 	else
 	{
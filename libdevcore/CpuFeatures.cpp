@@ -0,0 +1,68 @@
+/*
+	This file is part of cpp-ethereum.
+
+	cpp-ethereum is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	cpp-ethereum is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with cpp-ethereum.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file CpuFeatures.cpp
+ */
+
+#include "CpuFeatures.h"
+
+using namespace std;
+using namespace dev;
+
+bool dev::simdKernelSupported(SimdKernel _kernel)
+{
+	switch (_kernel)
+	{
+	case SimdKernel::Scalar:
+		return true;
+#if ETH_SIMD_X86
+	case SimdKernel::SSE4:
+		return __builtin_cpu_supports("sse4.1");
+	case SimdKernel::AVX2:
+		return __builtin_cpu_supports("avx2");
+	case SimdKernel::AVX512:
+		return __builtin_cpu_supports("avx512f");
+#else
+	default:
+		return false;
+#endif
+	}
+	return false;
+}
+
+SimdKernel dev::fastestSimdKernel(initializer_list<SimdKernel> _kernels)
+{
+	for (SimdKernel kernel: _kernels)
+		if (simdKernelSupported(kernel))
+			return kernel;
+	return SimdKernel::Scalar;
+}
+
+string dev::simdKernelName(SimdKernel _kernel)
+{
+	switch (_kernel)
+	{
+	case SimdKernel::Scalar:
+		return "scalar";
+	case SimdKernel::SSE4:
+		return "sse4";
+	case SimdKernel::AVX2:
+		return "avx2";
+	case SimdKernel::AVX512:
+		return "avx512";
+	}
+	return "unknown";
+}
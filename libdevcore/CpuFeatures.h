@@ -0,0 +1,52 @@
+/*
+	This file is part of cpp-ethereum.
+
+	cpp-ethereum is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	cpp-ethereum is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with cpp-ethereum.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file CpuFeatures.h
+ * Runtime selection of the SIMD kernels.
+ */
+
+#pragma once
+
+#include <initializer_list>
+#include <string>
+
+/// SIMD kernels are built with target attributes, so one binary runs on any x86-64 CPU
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define ETH_SIMD_X86 1
+#endif
+
+namespace dev
+{
+
+/// Instruction sets of the kernels, from the narrowest. A kernel may also use the narrower ones.
+enum class SimdKernel
+{
+	Scalar,
+	SSE4,
+	AVX2,
+	AVX512
+};
+
+/// @returns true if the build and the CPU support @a _kernel. Scalar is always supported.
+bool simdKernelSupported(SimdKernel _kernel);
+
+/// @returns the first of @a _kernels supported by the CPU, Scalar if none of them is.
+SimdKernel fastestSimdKernel(std::initializer_list<SimdKernel> _kernels);
+
+/// @returns the lower case name of @a _kernel, e.g. "avx2".
+std::string simdKernelName(SimdKernel _kernel);
+
+}
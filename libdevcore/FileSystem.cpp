@@ -116,3 +116,13 @@ fs::path dev::appendToFilename(fs::path const& _orig, string const& _suffix)
 	else
 		return _orig.parent_path() / fs::path( _orig.filename().string() + _suffix);
 }
+
+fs::path dev::uniqueTempPath(fs::path const& _file)
+{
+#if defined(_WIN32)
+	string const pid;
+#else
+	string const pid = "-" + to_string(getpid());
+#endif
+	return appendToFilename(_file, pid + fs::unique_path("-%%%%%%%%%%%%.tmp").string());
+}
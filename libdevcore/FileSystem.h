@@ -43,4 +43,7 @@ boost::filesystem::path getIpcPath();
 /// @returns a new path whose file name is suffixed with the given suffix.
 boost::filesystem::path appendToFilename(boost::filesystem::path const& _orig, std::string const& _suffix);
 
+/// @returns a path next to _file that no other thread or process uses, to be renamed over _file.
+boost::filesystem::path uniqueTempPath(boost::filesystem::path const& _file);
+
 }
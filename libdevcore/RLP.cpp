@@ -314,6 +314,40 @@ RLPStream& RLPStream::append(bytesConstRef _s, bool _compact)
 	return *this;
 }
 
+namespace
+{
+/// Big-endian bytes of the limbs of a fixed width integer, with leading zeros
+template <class T>
+bytesConstRef limbsBigEndian(T const& _i, byte* o_end)
+{
+	auto const& backend = _i.backend();
+	auto const* limbs = backend.limbs();
+	byte* b = o_end;
+	for (size_t i = 0; i < backend.size(); ++i)
+		for (size_t k = 0; k < sizeof(*limbs); ++k)
+			*(--b) = (byte)(limbs[i] >> (8 * k));
+	return bytesConstRef(b, o_end - b);
+}
+}
+
+RLPStream& RLPStream::append(unsigned _i)
+{
+	byte const b[4] = {(byte)(_i >> 24), (byte)(_i >> 16), (byte)(_i >> 8), (byte)_i};
+	return append(bytesConstRef(b, sizeof(b)), true);
+}
+
+RLPStream& RLPStream::append(u160 const& _i)
+{
+	byte b[32];
+	return append(limbsBigEndian(_i, b + sizeof(b)), true);
+}
+
+RLPStream& RLPStream::append(u256 const& _i)
+{
+	byte b[32];
+	return append(limbsBigEndian(_i, b + sizeof(b)), true);
+}
+
 RLPStream& RLPStream::append(bigint _i)
 {
 	if (!_i)
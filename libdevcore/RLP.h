@@ -396,12 +396,17 @@ public:
 	/// Initializes the RLPStream as a list of @a _listItems items.
 	explicit RLPStream(size_t _listItems) { appendList(_listItems); }
 
+	/// Initializes empty RLPStream that writes into @a _buffer, so that its capacity is reused.
+	/// Take the buffer back with swapOut().
+	explicit RLPStream(bytes&& _buffer): m_out(std::move(_buffer)) { m_out.clear(); }
+
 	~RLPStream() {}
 
 	/// Append given datum to the byte stream.
-	RLPStream& append(unsigned _s) { return append(bigint(_s)); }
-	RLPStream& append(u160 _s) { return append(bigint(_s)); }
-	RLPStream& append(u256 _s) { return append(bigint(_s)); }
+	/// Fixed width integers are written big-endian straight from their limbs, without a bigint.
+	RLPStream& append(unsigned _s);
+	RLPStream& append(u160 const& _s);
+	RLPStream& append(u256 const& _s);
 	RLPStream& append(bigint _s);
 	RLPStream& append(bytesConstRef _s, bool _compact = false);
 	RLPStream& append(bytes const& _s) { return append(bytesConstRef(&_s)); }
@@ -433,9 +438,12 @@ public:
 	/// Shift operators for appending data items.
 	template <class T> RLPStream& operator<<(T _data) { return append(_data); }
 
-	/// Clear the output stream so far.
+	/// Clear the output stream so far. The capacity is kept.
 	void clear() { m_out.clear(); m_listStack.clear(); }
 
+	/// Reserve the capacity of the output stream and of a few nested lists.
+	void reserve(size_t _size) { m_out.reserve(_size); m_listStack.reserve(c_reservedListDepth); }
+
 	/// Read the byte stream.
 	bytes const& out() const { if(!m_listStack.empty()) BOOST_THROW_EXCEPTION(RLPException() << errinfo_comment("listStack is not empty")); return m_out; }
 
@@ -461,6 +469,9 @@ private:
 			*(b--) = (byte)_i;
 	}
 
+	/// Nested lists of a block: block, transaction list, transaction.
+	static const size_t c_reservedListDepth = 4;
+
 	/// Our output byte stream.
 	bytes m_out;
 
@@ -25,6 +25,8 @@
 #include <cstdlib>
 #include <cstring>
 #include "RLP.h"
+#include <algorithm>
+#include <vector>
 using namespace std;
 using namespace dev;
 
@@ -208,6 +210,166 @@ defsha3(256)
 defsha3(384)
 defsha3(512)
 
+#if ETH_SIMD_X86
+
+/******** Keccak-f[1600] of several states in SIMD lanes ********/
+
+// State lane x + 5 * y of every input is in one vector. Same steps as keccakf above
+#define KECCAKF_LANES(V, XOR, ANDNOT, ROL, CONST)                        \
+  for (int round = 0; round < 24; round++) {                             \
+	V c[5];                                                                \
+	for (int x = 0; x < 5; x++)                                            \
+	  c[x] = XOR(XOR(XOR(a[x], a[x + 5]), XOR(a[x + 10], a[x + 15])), a[x + 20]); \
+	for (int x = 0; x < 5; x++) {                                          \
+	  V const d = XOR(c[(x + 4) % 5], ROL(c[(x + 1) % 5], 1));             \
+	  for (int y = 0; y < 25; y += 5)                                      \
+		a[y + x] = XOR(a[y + x], d);                                       \
+	}                                                                      \
+	V t = a[1];                                                            \
+	for (int i = 0; i < 24; i++) {                                         \
+	  V const b = a[pi[i]];                                                \
+	  a[pi[i]] = ROL(t, rho[i]);                                           \
+	  t = b;                                                               \
+	}                                                                      \
+	for (int y = 0; y < 25; y += 5) {                                      \
+	  V const b0 = a[y], b1 = a[y + 1], b2 = a[y + 2], b3 = a[y + 3], b4 = a[y + 4]; \
+	  a[y] = XOR(b0, ANDNOT(b1, b2));                                      \
+	  a[y + 1] = XOR(b1, ANDNOT(b2, b3));                                  \
+	  a[y + 2] = XOR(b2, ANDNOT(b3, b4));                                  \
+	  a[y + 3] = XOR(b3, ANDNOT(b4, b0));                                  \
+	  a[y + 4] = XOR(b4, ANDNOT(b0, b1));                                  \
+	}                                                                      \
+	a[0] = XOR(a[0], CONST(RC[round]));                                    \
+  }
+
+/// Rate of sha3_256 in bytes and 64 bit words
+static const size_t c_rate = 136;
+static const size_t c_rateWords = c_rate / 8;
+
+/// Words of block _block of the padded input, zeros after the last block
+static inline void paddedBlock(bytesConstRef _input, size_t _block, uint64_t* o_words)
+{
+	uint8_t block[c_rate] = {0};
+	size_t const offset = _block * c_rate;
+	if (offset + c_rate <= _input.size())
+		memcpy(block, _input.data() + offset, c_rate);
+	else if (offset <= _input.size())
+	{
+		size_t const rest = _input.size() - offset;
+		memcpy(block, _input.data() + offset, rest);
+		block[rest] ^= 0x01;
+		block[c_rate - 1] ^= 0x80;
+	}
+	memcpy(o_words, block, c_rate);  // x86 is little endian as the Keccak lanes
+}
+
+/// Hash up to LANES inputs at once. Inputs that are already absorbed are permuted along with
+/// the others, the hash of an input is read after its last block
+#define KECCAK_MANY(LANES, V)                                                                 \
+	size_t blocks[LANES];                                                                 \
+	size_t maxBlocks = 0;                                                                 \
+	for (size_t j = 0; j < LANES; j++)                                                    \
+	{                                                                                     \
+		blocks[j] = j < _count ? _inputs[j].size() / c_rate + 1 : 0;                      \
+		maxBlocks = std::max(maxBlocks, blocks[j]);                                       \
+	}                                                                                     \
+	V a[25];                                                                              \
+	for (size_t k = 0; k < 25; k++)                                                       \
+		a[k] = V();                                                                       \
+	alignas(64) uint64_t words[c_rateWords][LANES];                                      \
+	alignas(64) uint64_t out[4][LANES];                                                  \
+	for (size_t block = 0; block < maxBlocks; block++)                                    \
+	{                                                                                     \
+		for (size_t j = 0; j < LANES; j++)                                                \
+		{                                                                                 \
+			uint64_t lane[c_rateWords] = {0};                                             \
+			if (j < _count)                                                               \
+				paddedBlock(_inputs[j], block, lane);                                     \
+			for (size_t k = 0; k < c_rateWords; k++)                                      \
+				words[k][j] = lane[k];                                                    \
+		}                                                                                 \
+		for (size_t k = 0; k < c_rateWords; k++)                                          \
+		{                                                                                 \
+			V w;                                                                          \
+			memcpy(&w, words[k], sizeof(V));                                              \
+			a[k] ^= w;                                                                    \
+		}                                                                                 \
+		KECCAKF_LANES(V, LANES_XOR, LANES_ANDNOT, LANES_ROL, LANES_CONST)                  \
+		for (size_t k = 0; k < 4; k++)                                                    \
+			LANES_STORE(out[k], a[k]);                                                    \
+		for (size_t j = 0; j < _count && j < LANES; j++)                                  \
+			if (blocks[j] == block + 1)                                                   \
+				for (size_t k = 0; k < 4; k++)                                            \
+					memcpy(o_outputs[j].data() + k * 8, &out[k][j], 8);                   \
+	}
+
+// Vector extensions: the compiler selects the instructions of the function target
+typedef uint64_t Lanes4 __attribute__((vector_size(32)));
+typedef uint64_t Lanes8 __attribute__((vector_size(64)));
+#define LANES_STORE(p, v) memcpy(p, &v, sizeof(v))
+#define LANES_XOR(x, y) ((x) ^ (y))
+#define LANES_ANDNOT(x, y) (~(x) & (y))
+#define LANES_ROL(v, n) (((v) << (n)) | ((v) >> (64 - (n))))
+#define LANES_CONST(c) (c)
+
+__attribute__((target("avx2")))
+static void keccak4(bytesConstRef const* _inputs, size_t _count, h256* o_outputs)
+{
+	KECCAK_MANY(4, Lanes4)
+}
+
+__attribute__((target("avx512f")))
+static void keccak8(bytesConstRef const* _inputs, size_t _count, h256* o_outputs)
+{
+	KECCAK_MANY(8, Lanes8)
+}
+
+#endif  // ETH_SIMD_X86
+
+}
+
+void sha3_many(bytesConstRef const* _inputs, size_t _count, h256* o_outputs)
+{
+	static SimdKernel const kernel = fastestSimdKernel({SimdKernel::AVX512, SimdKernel::AVX2});
+	sha3_many(_inputs, _count, o_outputs, kernel);
+}
+
+void sha3_many(bytesConstRef const* _inputs, size_t _count, h256* o_outputs, SimdKernel _kernel)
+{
+	if (!simdKernelSupported(_kernel))
+		_kernel = SimdKernel::Scalar;
+	size_t const lanes = _kernel == SimdKernel::AVX512 ? 8 : _kernel == SimdKernel::AVX2 ? 4 : 1;
+
+	vector<size_t> order(_count);
+	for (size_t i = 0; i < _count; i++)
+		order[i] = i;
+
+	size_t i = 0;
+#if ETH_SIMD_X86
+	// Inputs of the same number of blocks go to one batch, so the lanes are not idle
+	if (lanes > 1)
+		stable_sort(order.begin(), order.end(), [_inputs](size_t _a, size_t _b) {
+			return _inputs[_a].size() / keccak::c_rate < _inputs[_b].size() / keccak::c_rate;
+		});
+	bytesConstRef batch[8];
+	h256 hashes[8];
+	// a batch that would fill less than half of the lanes is hashed by the scalar code
+	while (lanes > 1 && i + lanes / 2 <= _count)
+	{
+		size_t const count = min(lanes, _count - i);
+		for (size_t j = 0; j < count; j++)
+			batch[j] = _inputs[order[i + j]];
+		if (lanes == 8)
+			keccak::keccak8(batch, count, hashes);
+		else
+			keccak::keccak4(batch, count, hashes);
+		for (size_t j = 0; j < count; j++)
+			o_outputs[order[i + j]] = hashes[j];
+		i += count;
+	}
+#endif
+	for (; i < _count; i++)
+		o_outputs[order[i]] = sha3(_inputs[order[i]]);
 }
 
 bool sha3(bytesConstRef _input, bytesRef o_output)
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <string>
+#include "CpuFeatures.h"
 #include "FixedHash.h"
 #include "vector_ref.h"
 
@@ -61,6 +62,18 @@ template<unsigned N> inline SecureFixedHash<32> sha3Secure(SecureFixedHash<N> co
 /// Calculate SHA3-256 hash of the given input, possibly interpreting it as nibbles, and return the hash as a string filled with binary data.
 inline std::string sha3(std::string const& _input, bool _isNibbles) { return asString((_isNibbles ? sha3(fromHex(_input)) : sha3(bytesConstRef(&_input))).asBytes()); }
 
+/// Calculate SHA3-256 hashes of many inputs. Several inputs are hashed at once in SIMD lanes when
+/// the CPU supports it, the results are the same as of sha3() for each input.
+/// The AVX2 kernel hashes 4 inputs in parallel, AVX512 8, the other kernels are scalar.
+void sha3_many(bytesConstRef const* _inputs, size_t _count, h256* o_outputs);
+void sha3_many(bytesConstRef const* _inputs, size_t _count, h256* o_outputs, SimdKernel _kernel);
+inline std::vector<h256> sha3_many(std::vector<bytesConstRef> const& _inputs)
+{
+	std::vector<h256> ret(_inputs.size());
+	sha3_many(_inputs.data(), _inputs.size(), ret.data());
+	return ret;
+}
+
 /// Calculate SHA3-256 MAC
 inline void sha3mac(bytesConstRef _secret, bytesConstRef _plain, bytesRef _output) { sha3(_secret.toBytes() + _plain.toBytes()).ref().populate(_output); }
 
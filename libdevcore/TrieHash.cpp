@@ -0,0 +1,162 @@
+/*
+	This file is part of cpp-ethereum.
+
+	cpp-ethereum is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	cpp-ethereum is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with cpp-ethereum.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file TrieHash.cpp
+ */
+
+#include "TrieHash.h"
+#include "CommonData.h"
+#include "RLP.h"
+#include "SHA3.h"
+#include <algorithm>
+
+using namespace std;
+
+namespace dev
+{
+
+h256 const EmptyTrie = sha3(rlp(string()));
+
+namespace
+{
+// Trie path in nibbles and the value stored under it
+using Entry = pair<bytes, bytesConstRef>;
+using EntryIt = vector<Entry>::const_iterator;
+
+void encodeNode(EntryIt _begin, EntryIt _end, size_t _prefix, RLPStream& _out);
+
+// Reference to the child node: nodes shorter than 32 bytes are inlined into the parent
+void appendChild(EntryIt _begin, EntryIt _end, size_t _prefix, RLPStream& _out)
+{
+	RLPStream node;
+	encodeNode(_begin, _end, _prefix, node);
+	if (node.out().size() < 32)
+		_out.appendRaw(node.out());
+	else
+		_out << sha3(node.out());
+}
+
+// Node of the sorted entries [_begin, _end) that share first _prefix nibbles of the path
+void encodeNode(EntryIt _begin, EntryIt _end, size_t _prefix, RLPStream& _out)
+{
+	if (_begin == _end)
+	{
+		_out << "";
+		return;
+	}
+
+	bytes const& first = _begin->first;
+	if (next(_begin) == _end)
+	{
+		_out.appendList(2) << hexPrefixEncode(first, true, _prefix, first.size()) << _begin->second;
+		return;
+	}
+
+	// Entries are sorted, so the path shared by all of them is the one of the first and the last
+	bytes const& last = prev(_end)->first;
+	size_t shared = _prefix;
+	size_t const maxShared = min(first.size(), last.size());
+	while (shared < maxShared && first[shared] == last[shared])
+		++shared;
+
+	if (shared > _prefix)
+	{
+		// extension node
+		_out.appendList(2) << hexPrefixEncode(first, false, _prefix, shared);
+		appendChild(_begin, _end, shared, _out);
+		return;
+	}
+
+	// branch node. A path that ends here is the first one and goes to the value slot
+	_out.appendList(17);
+	bool const hasValue = first.size() == _prefix;
+	EntryIt child = hasValue ? next(_begin) : _begin;
+	for (byte nibble = 0; nibble < 16; ++nibble)
+	{
+		EntryIt childEnd = child;
+		while (childEnd != _end && childEnd->first[_prefix] == nibble)
+			++childEnd;
+		if (childEnd == child)
+			_out << "";
+		else
+			appendChild(child, childEnd, _prefix + 1, _out);
+		child = childEnd;
+	}
+	if (hasValue)
+		_out << _begin->second;
+	else
+		_out << "";
+}
+
+h256 rootOfSorted(vector<Entry> const& _entries)
+{
+	if (_entries.empty())
+		return EmptyTrie;
+	RLPStream root;
+	encodeNode(_entries.begin(), _entries.end(), 0, root);
+	return sha3(root.out());
+}
+}
+
+bytes hexPrefixEncode(bytes const& _nibbles, bool _isLeaf, size_t _begin, size_t _end)
+{
+	bool const odd = (_end - _begin) % 2;
+	bytes ret(1, ((_isLeaf ? 2 : 0) | (odd ? 1 : 0)) * 16);
+	size_t i = _begin;
+	if (odd)
+		ret[0] |= _nibbles[i++];
+	for (; i < _end; i += 2)
+		ret.push_back(_nibbles[i] * 16 + _nibbles[i + 1]);
+	return ret;
+}
+
+h256 trieRoot(BytesMap const& _entries)
+{
+	// byte order of the map keys is the nibble order of the paths
+	vector<Entry> entries;
+	entries.reserve(_entries.size());
+	for (auto const& entry : _entries)
+		entries.emplace_back(asNibbles(bytesConstRef(&entry.first)), bytesConstRef(&entry.second));
+	return rootOfSorted(entries);
+}
+
+h256 secureTrieRoot(BytesMap const& _entries)
+{
+	vector<bytesConstRef> keys;
+	keys.reserve(_entries.size());
+	for (auto const& entry : _entries)
+		keys.emplace_back(&entry.first);
+	vector<h256> const hashedKeys = sha3_many(keys);
+
+	vector<Entry> entries;
+	entries.reserve(_entries.size());
+	size_t i = 0;
+	for (auto const& entry : _entries)
+		entries.emplace_back(asNibbles(hashedKeys[i++].ref()), bytesConstRef(&entry.second));
+	sort(entries.begin(), entries.end(),
+		[](Entry const& _a, Entry const& _b) { return _a.first < _b.first; });
+	return rootOfSorted(entries);
+}
+
+h256 orderedTrieRoot(vector<bytes> const& _values)
+{
+	BytesMap entries;
+	for (size_t i = 0; i < _values.size(); ++i)
+		entries[rlp(i)] = _values[i];
+	return trieRoot(entries);
+}
+
+}
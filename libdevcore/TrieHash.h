@@ -0,0 +1,46 @@
+/*
+	This file is part of cpp-ethereum.
+
+	cpp-ethereum is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	cpp-ethereum is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with cpp-ethereum.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file TrieHash.h
+ * Root hash of a Merkle Patricia trie built at once from all of its entries.
+ */
+
+#pragma once
+
+#include "Common.h"
+#include "FixedHash.h"
+
+namespace dev
+{
+
+/// Root of the trie with no entries: sha3(rlp(""))
+extern h256 const EmptyTrie;
+
+/// Root hash of the trie with the given key => value entries. Values are stored as given
+/// (RLP encode them before if required). The trie is built bottom-up from the sorted keys,
+/// without any node database
+h256 trieRoot(BytesMap const& _entries);
+
+/// Root hash of the secure trie: keys are replaced with their sha3 (state and storage tries)
+h256 secureTrieRoot(BytesMap const& _entries);
+
+/// Root hash of the trie with rlp(index) => value entries (transactions, receipts tries)
+h256 orderedTrieRoot(std::vector<bytes> const& _values);
+
+/// Hex prefix encoding of the nibbles [_begin, _end) of a trie path
+bytes hexPrefixEncode(bytes const& _nibbles, bool _isLeaf, size_t _begin, size_t _end);
+
+}
@@ -45,6 +45,11 @@ void eth_log_message(std::string const& _message, unsigned _verbosity, LogColor
     }
 }
 
+bool eth_log_enabled(unsigned _verbosity)
+{
+    return Options::get().logVerbosity >= _verbosity;
+}
+
 void eth_error(std::string const& _message)
 {
     if (TestOutputHelper::get().markError(_message)) // if the exception is not allowed, then throw an exception
@@ -14,6 +14,7 @@ void eth_stdout_message(std::string const& _message);
 void eth_stderror_message(std::string const& _message);
 void eth_log_message(
     std::string const& _message, unsigned _verbosity, LogColor _logColor = LogColor::DEFAULT);
+bool eth_log_enabled(unsigned _verbosity);
 void eth_require(bool _flag);
 void eth_check_message(bool _flag, std::string const& _message);
 void eth_require_message(bool _flag, std::string const& _message);
@@ -22,36 +23,70 @@ void eth_error(std::string const& _message);
 void eth_mark_error(bool _flag, std::string const& _message);
 void eth_mark_error(std::string const& _message);
 
+// Macro arguments are only evaluated when the message is going to be used.
+// So it is cheap to log the heavy objects (json dumps, file contents) with high verbosity
+
 // Prints output to stderr/cout (depending on --verbosity option)
-#define ETH_WARNING(message) test::eth_warning_message(message)
-#define ETH_WARNING_TEST(message, verbosity) test::eth_warning_message(message, verbosity)
+#define ETH_WARNING(message) ETH_WARNING_TEST(message, 1)
+#define ETH_WARNING_TEST(message, verbosity)               \
+    do                                                     \
+    {                                                      \
+        if (test::eth_log_enabled(verbosity))              \
+            test::eth_warning_message(message, verbosity); \
+    } while (0)
 
 #define ETH_STDOUT_MESSAGE(message) test::eth_stdout_message(message)
 #define ETH_STDERROR_MESSAGE(message) test::eth_stderror_message(message)
-#define ETH_TEST_MESSAGE(message) test::eth_log_message(message, 6)
-#define ETH_LOG(message, verbosity) test::eth_log_message(message, verbosity)
-#define ETH_LOGC(message, verbosity, color) test::eth_log_message(message, verbosity, color)
+#define ETH_TEST_MESSAGE(message) ETH_LOG(message, 6)
+#define ETH_LOG(message, verbosity)                    \
+    do                                                 \
+    {                                                  \
+        if (test::eth_log_enabled(verbosity))          \
+            test::eth_log_message(message, verbosity); \
+    } while (0)
+#define ETH_LOGC(message, verbosity, color)                   \
+    do                                                        \
+    {                                                         \
+        if (test::eth_log_enabled(verbosity))                 \
+            test::eth_log_message(message, verbosity, color); \
+    } while (0)
 
 // Notice an error during test execution, but continue other tests
 // Throw the exception so to exit the test execution loop
 #define ETH_ERROR_MESSAGE(message) test::eth_error(message)
-#define ETH_ERROR_REQUIRE_MESSAGE(flag, message) test::eth_check_message(flag, message)
+#define ETH_ERROR_REQUIRE_MESSAGE(flag, message) \
+    do                                           \
+    {                                            \
+        if (!(flag))                             \
+            test::eth_error(message);            \
+    } while (0)
 
 // Notice an error during test execution, but continue current test
 // Thie needed to mark multiple error checks into the log in one test
 #define ETH_MARK_ERROR(message) test::eth_mark_error(message)
-#define ETH_MARK_ERROR_FLAG(flag, message) test::eth_mark_error(flag, message)
+#define ETH_MARK_ERROR_FLAG(flag, message) \
+    do                                     \
+    {                                      \
+        if (!(flag))                       \
+            test::eth_mark_error(message); \
+    } while (0)
 
 // Stop retesteth execution rise sigabrt
 #define ETH_FAIL_REQUIRE(flag) test::eth_require(flag)
 #define ETH_FAIL_MESSAGE(message) test::eth_fail(message)
-#define ETH_FAIL_REQUIRE_MESSAGE(flag, message) test::eth_require_message(flag, message)
+#define ETH_FAIL_REQUIRE_MESSAGE(flag, message) \
+    do                                          \
+    {                                           \
+        if (!(flag))                            \
+            test::eth_fail(message);            \
+    } while (0)
 
 // Helpers
 template <class T>
 void eth_check_equal(T a, T b, std::string const& _message)
 {
-    eth_check_message(a == b, _message + test::expButGot(b, a));
+    if (!(a == b))
+        eth_error(_message + test::expButGot(b, a));
 }
 #define ETH_CHECK_EQUAL(val1, val2, message) test::eth_check_equal(val1, val2, message)
 
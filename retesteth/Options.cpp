@@ -72,6 +72,36 @@ void printHelp()
     cout << setw(30) << "--statediff" << setw(25) << "Trace state difference for state tests\n";
     cout << setw(30) << "--stderr" << setw(25) << "Redirect ipc client stderr to stdout\n";
     cout << setw(30) << "--travisout" << setw(25) << "Output `.` to stdout\n";
+    cout << setw(30) << "--genesiscache" << setw(25)
+         << "Store genesis blocks calculated by t8n tool in datadir for next runs\n";
+    cout << setw(30) << "--t8ncache" << setw(25)
+         << "Reuse t8n tool results from previous runs stored in datadir\n";
+    cout << setw(30) << "--t8ncachesize <MB>" << setw(25)
+         << "Remove least recently used t8n cache entries above this size (default: 1024)\n";
+    cout << setw(30) << "--t8ncacheverify <N>" << setw(25)
+         << "Execute t8n tool on each N-th cache hit to check that the tool is deterministic\n";
+    cout << setw(30) << "--t8nbatch <N>" << setw(25)
+         << "Execute state test transactions of a fork with up to N t8n processes at once (all threads)\n";
+    cout << setw(30) << "--longestfirst" << setw(25)
+         << "Run the tests that took longest in previous runs (datadir/timings.json) first\n";
+    cout << setw(30) << "--shard <i/N>" << setw(25)
+         << "Run only test files of the shard i of N (1 <= i <= N)\n";
+    cout << setw(30) << "--shardbalance" << setw(25)
+         << "Split test files between shards by timings from datadir instead of file hash\n";
+    cout << setw(30) << "--shardresult <file>" << setw(25)
+         << "Shard result file (default: shard_<i>_of_<N>.json)\n";
+    cout << setw(30) << "--mergeshards <files>" << setw(25)
+         << "Print the summary of shard result files and exit\n";
+    cout << setw(30) << "--incremental" << setw(25)
+         << "Skip tests that passed with the same test, client and options (datadir/journal)\n";
+    cout << setw(30) << "--fullrun" << setw(25)
+         << "Run all tests and record the passed ones for --incremental\n";
+    cout << setw(30) << "--resume" << setw(25)
+         << "With --filltests skip fillers completed before if their output is unchanged\n";
+    cout << setw(30) << "--phaselog <file>" << setw(25)
+         << "Write time of test phases per test file and test, ms in .json, us in .csv\n";
+    cout << setw(30) << "--tracelog <file>" << setw(25)
+         << "Write test phases of each thread as Chrome trace events (chrome://tracing)\n";
 
     cout << "\nAdditional Tests\n";
     cout << setw(30) << "--all" << setw(25) << "Enable all tests\n";
@@ -203,6 +233,71 @@ Options::Options(int argc, const char** argv)
 		}
 		else if (arg == "--exectimelog")
 			exectimelog = true;
+        else if (arg == "--genesiscache")
+            genesiscache = true;
+        else if (arg == "--t8ncache")
+            t8ncache = true;
+        else if (arg == "--t8ncachesize")
+        {
+            throwIfNoArgumentFollows();
+            t8ncache = true;
+            t8ncacheSize = max(1, atoi(argv[++i]));
+        }
+        else if (arg == "--t8ncacheverify")
+        {
+            throwIfNoArgumentFollows();
+            t8ncache = true;
+            t8ncacheVerify = max(0, atoi(argv[++i]));
+        }
+        else if (arg == "--t8nbatch")
+        {
+            throwIfNoArgumentFollows();
+            t8nbatch = max(0, atoi(argv[++i]));
+        }
+        else if (arg == "--longestfirst")
+            longestfirst = true;
+        else if (arg == "--shard")
+        {
+            throwIfNoArgumentFollows();
+            string const shard = argv[++i];
+            size_t const pos = shard.find('/');
+            if (pos != string::npos)
+            {
+                shardIndex = max(0, atoi(shard.substr(0, pos).c_str()));
+                shardCount = max(0, atoi(shard.substr(pos + 1).c_str()));
+            }
+            if (shardCount == 0 || shardIndex == 0 || shardIndex > shardCount)
+                BOOST_THROW_EXCEPTION(InvalidOption("--shard expects <i/N> with 1 <= i <= N"));
+        }
+        else if (arg == "--shardbalance")
+            shardbalance = true;
+        else if (arg == "--shardresult")
+        {
+            throwIfNoArgumentFollows();
+            shardResultFile = argv[++i];
+        }
+        else if (arg == "--mergeshards")
+        {
+            throwIfNoArgumentFollows();
+            while (i + 1 < argc && string(argv[i + 1]).substr(0, 2) != "--")
+                mergeShardFiles.push_back(argv[++i]);
+        }
+        else if (arg == "--incremental")
+            incremental = true;
+        else if (arg == "--fullrun")
+            fullrun = true;
+        else if (arg == "--resume")
+            resume = true;
+        else if (arg == "--phaselog")
+        {
+            throwIfNoArgumentFollows();
+            phaselog = argv[++i];
+        }
+        else if (arg == "--tracelog")
+        {
+            throwIfNoArgumentFollows();
+            tracelog = argv[++i];
+        }
 		else if (arg == "--all")
 			all = true;
 		else if (arg == "--singletest")
@@ -428,9 +523,15 @@ void displayTestSuites()
     cout << "\nRetesteth unit tests:\n";
     cout << setw(30) << "-t DataObjectTestSuite" << setw(0) << "Unit tests for json parsing\n";
     cout << setw(30) << "-t EthObjectsSuite" << setw(0) << "Unit tests for test data objects\n";
+    cout << setw(30) << "-t HexSuite" << setw(0) << "Unit tests for hex conversion\n";
     cout << setw(30) << "-t LLLCSuite" << setw(0) << "Unit tests for external solidity compiler\n";
     cout << setw(30) << "-t OptionsSuite" << setw(0) << "Unit tests for this cmd menu\n";
+    cout << setw(30) << "-t RLPSuite" << setw(0) << "Unit tests for RLP encoding\n";
+    cout << setw(30) << "-t SHA3Suite" << setw(0) << "Unit tests for batch keccak hashing\n";
+    cout << setw(30) << "-t SigningSuite" << setw(0) << "Unit tests for transaction signing\n";
     cout << setw(30) << "-t TestHelperSuite" << setw(0) << "Unit tests for retesteth logic\n";
+    cout << setw(30) << "-t TrieSuite" << setw(0) << "Unit tests for trie and state root hashing\n";
+    cout << setw(30) << "-t WorkerPoolSuite" << setw(0) << "Unit tests for test scheduler\n";
     cout << "\n";
 }
 
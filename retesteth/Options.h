@@ -23,12 +23,18 @@ public:
     {
         DynamicOptions() {}
         std::vector<ClientConfig> const& getClientConfigs();
+
+        // Current config is set per thread, so different clients could be tested at once
+        // It is an error to get the config on a thread that did not set it
         ClientConfig const& getCurrentConfig() const;
+        bool hasCurrentConfig() const;
         void setCurrentConfig(ClientConfig const& _config);
 
+        // More than one client config is loaded (--clients)
+        bool isMultiClient() const { return m_clientConfigs.size() > 1; }
+
     private:
         std::vector<ClientConfig> m_clientConfigs;
-        test::ClientConfigID m_currentConfigID;
     };
 
     size_t threadCount = 1;	///< Execute tests on threads
@@ -45,6 +51,22 @@ public:
     fs::path datadir;         ///< Path to datadir (~/.retesteth)
     DataObject nodesoverride;  ///< ["IP:port", ""IP:port""] array
     bool exectimelog = false; ///< Print execution time for each test suite
+    bool genesiscache = false;  ///< Store genesis blocks calculated by t8n tool in datadir
+    bool t8ncache = false;      ///< Reuse t8n tool results stored in datadir
+    size_t t8ncacheSize = 1024; ///< t8n cache size limit in MB
+    size_t t8ncacheVerify = 0;  ///< Execute t8n tool on each N-th cache hit to verify the entry
+    size_t t8nbatch = 0;        ///< Max t8n processes to execute state test transactions at once
+    bool longestfirst = false;  ///< Dispatch test files with the longest expected time first
+    size_t shardIndex = 0;       ///< Run only test files of this shard [1, shardCount]
+    size_t shardCount = 0;       ///< Number of shards, 0 if sharding is disabled
+    bool shardbalance = false;   ///< Assign files to shards by stored timings
+    std::string shardResultFile; ///< Machine readable result of the shard run
+    std::vector<std::string> mergeShardFiles;  ///< Print summary of these shard results and exit
+    bool incremental = false;  ///< Skip tests that passed with the same inputs and client
+    bool fullrun = false;      ///< Run all tests, but record passed tests for --incremental
+    bool resume = false;       ///< Skip filler files filled before (datadir/journal)
+    std::string phaselog;      ///< Time of the test phases per file and test (.json or .csv)
+    std::string tracelog;      ///< Test phases of the worker threads as Chrome trace events
 	std::string rCurrentTestSuite; ///< Remember test suite before boost overwrite (for random tests)
     bool statediff = false;        ///< Fill full post state in General tests
     bool fullstate = false;        ///< Replace large state output to it's hash
@@ -84,4 +106,7 @@ private:
     friend class TestOptions;
 };
 
+/// Path to retesteth configs (--datadir or ~/.retesteth)
+fs::path getRetestethDataDir();
+
 } //namespace test
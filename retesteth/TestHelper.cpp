@@ -13,6 +13,7 @@
 #include <retesteth/Options.h>
 #include <retesteth/TestHelper.h>
 #include <retesteth/TestOutputHelper.h>
+#include <retesteth/TestTrace.h>
 #include <retesteth/dataObject/ConvertFile.h>
 #include <retesteth/dataObject/ConvertYaml.h>
 
@@ -398,6 +399,7 @@ void checkHexHasEvenLength(string const& _hex)
 
 string compileLLL(string const& _code)
 {
+    PhaseTimer timer(TestPhase::Compile);
 #if defined(_WIN32)
 	BOOST_ERROR("LLL compilation only supported on posix systems.");
 	return "";
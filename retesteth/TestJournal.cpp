@@ -0,0 +1,127 @@
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/SHA3.h>
+#include <retesteth/EthChecks.h>
+#include <retesteth/Options.h>
+#include <retesteth/TestHelper.h>
+#include <retesteth/TestJournal.h>
+#include <retesteth/TestOutputHelper.h>
+#include <retesteth/session/RPCSession.h>
+#include <retesteth/session/ToolCache.h>
+#include <fstream>
+#include <map>
+
+using namespace std;
+
+namespace
+{
+// Client config files (config, genesis templates) and the client binary version
+// Computed once per config with the session of the calling thread
+string clientIdentity(ClientConfig const& _config)
+{
+    static std::mutex s_identityMutex;
+    static std::map<string, string> s_identities;
+    {
+        std::lock_guard<std::mutex> lock(s_identityMutex);
+        auto const it = s_identities.find(_config.getName());
+        if (it != s_identities.end())
+            return it->second;
+    }
+
+    string identity = _config.getName();
+    fs::path const configDir = _config.getConfigFilePath().parent_path();
+    if (fs::exists(configDir))
+    {
+        std::set<fs::path> configFiles;
+        for (fs::recursive_directory_iterator it(configDir); it != fs::recursive_directory_iterator(); ++it)
+            if (fs::is_regular_file(it->path()))
+                configFiles.insert(it->path());
+        for (auto const& file : configFiles)
+            identity += file.string() + ":" + toString(dev::sha3(dev::contentsString(file)));
+    }
+
+    if (_config.getSocketType() == Socket::SocketType::TransitionTool)
+        identity += toolimpl::toolIdentity(_config.getAddress());
+    else
+        identity += RPCSession::instance(TestOutputHelper::getThreadID()).web3_clientVersion();
+
+    std::lock_guard<std::mutex> lock(s_identityMutex);
+    s_identities.emplace(_config.getName(), identity);
+    return identity;
+}
+
+// Options that change what is executed or filled
+string optionsKey()
+{
+    Options const& opt = Options::get();
+    return opt.singleSubTestName + ":" + opt.singleTestNet + ":" + toString(opt.trDataIndex) +
+           ":" + toString(opt.trGasIndex) + ":" + toString(opt.trValueIndex) + ":" +
+           toString(opt.fullstate) + ":" + toString(opt.fillchain) + ":" + toString(opt.statediff) +
+           ":" + toString(opt.blockLimit) + ":" + toString(opt.rpcLimit);
+}
+
+string testFileKey(fs::path const& _file)
+{
+    return fs::relative(_file, test::getTestPath()).string() +
+           toString(dev::sha3(dev::contentsString(_file)));
+}
+}  // namespace
+
+namespace test
+{
+TestJournal::TestJournal(fs::path const& _file) : m_file(_file)
+{
+    fs::create_directories(m_file.parent_path());
+    std::ifstream journal(m_file.string());
+    string line;
+    while (std::getline(journal, line))
+        if (!line.empty())
+            m_entries.insert(line);
+}
+
+bool TestJournal::contains(string const& _key) const
+{
+    std::lock_guard<std::mutex> lock(m_journalMutex);
+    return m_entries.count(_key);
+}
+
+void TestJournal::add(string const& _key)
+{
+    std::lock_guard<std::mutex> lock(m_journalMutex);
+    if (!m_entries.insert(_key).second)
+        return;
+    std::ofstream journal(m_file.string(), std::ios::app);
+    journal << _key + "\n" << std::flush;
+}
+
+TestJournal& passedTestsJournal()
+{
+    static TestJournal journal(getRetestethDataDir() / "journal" / "passed");
+    return journal;
+}
+
+string passedTestKey(fs::path const& _compiledTest)
+{
+    ClientConfig const& config = Options::getDynamicOptions().getCurrentConfig();
+    return toString(dev::sha3(testFileKey(_compiledTest) + clientIdentity(config) + optionsKey()));
+}
+
+TestJournal& filledTestsJournal()
+{
+    static TestJournal journal(getRetestethDataDir() / "journal" / "filled");
+    return journal;
+}
+
+string filledTestKey(fs::path const& _filler)
+{
+    ClientConfig const& config = Options::getDynamicOptions().getCurrentConfig();
+    return toString(dev::sha3(testFileKey(_filler) + clientIdentity(config) + optionsKey()));
+}
+
+string filledTestEntry(string const& _filledKey, fs::path const& _output)
+{
+    if (!fs::exists(_output))
+        return string();
+    return _filledKey + " " + toString(dev::sha3(dev::contentsString(_output)));
+}
+
+}  // namespace test
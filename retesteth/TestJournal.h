@@ -0,0 +1,43 @@
+#pragma once
+#include <retesteth/configs/ClientConfig.h>
+#include <boost/filesystem.hpp>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace fs = boost::filesystem;
+namespace test
+{
+// Append only file of keys, one per line. Shared by threads and by retesteth instances: each
+// instance loads the file once and appends the new keys with a single write
+class TestJournal
+{
+public:
+    TestJournal(fs::path const& _file);
+    bool contains(std::string const& _key) const;
+    void add(std::string const& _key);
+
+private:
+    fs::path m_file;
+    mutable std::mutex m_journalMutex;
+    std::set<std::string> m_entries;
+};
+
+// Tests passed by a client (--incremental), <datadir>/journal/passed
+TestJournal& passedTestsJournal();
+
+// Key of the compiled test run: test content, client config and binary, options that change
+// what is executed. A recorded key means the same run has already passed
+std::string passedTestKey(fs::path const& _compiledTest);
+
+// Filler files filled by a client (--resume), <datadir>/journal/filled
+TestJournal& filledTestsJournal();
+
+// Key of the filler fill: filler content, client config and binary, options
+std::string filledTestKey(fs::path const& _filler);
+
+// Fill record with the hash of the output file. A recorded entry means the fill has completed and
+// the output is still the one it produced. Empty if there is no output file
+std::string filledTestEntry(std::string const& _filledKey, fs::path const& _output);
+
+}  // namespace test
@@ -18,13 +18,16 @@
  * Fixture class for boost output when running testeth
  */
 
+#include <atomic>
 #include <mutex>
 #include <thread>
 #include <boost/test/unit_test.hpp>
 #include <libdevcore/include.h>
 #include <retesteth/TestOutputHelper.h>
 #include <retesteth/Options.h>
+#include <retesteth/TestTrace.h>
 #include <retesteth/ExitHandler.h>
+#include <retesteth/ethObjects/stateTest/scheme_transaction.h>
 #include <libdevcore/Log.h>
 
 using namespace std;
@@ -41,28 +44,96 @@ void checkUnfinishedTestFolders();  // Checkup that all test folders are active
 typedef std::pair<double, std::string> execTimeName;
 static std::vector<execTimeName> execTimeResults;
 static int execTotalErrors = 0;
-static std::map<std::string, TestOutputHelper> helperThreadMap; // threadID => outputHelper
 mutex g_numberOfRunningTests;
 mutex g_totalTestsRun;
 mutex g_failedTestsMap;
 mutex g_execTotalErrors;
 static int numberOfRunningTests = 0;
 static int totalTestsRun = 0;
+static int totalTestsSkipped = 0;
 static std::map<std::string, std::string> s_failedTestsMap;
 
-mutex g_helperThreadMapMutex;
+// Errors are reported per client config when more than one client is tested
+string clientErrorPrefix()
+{
+    if (!Options::getDynamicOptions().isMultiClient() ||
+        !Options::getDynamicOptions().hasCurrentConfig())
+        return string();
+    return "[" + Options::getDynamicOptions().getCurrentConfig().getName() + "] ";
+}
+
+// Threads that run the tests of one client at once count their errors. BOOST_ERROR is not
+// thread safe, it is raised for them on the Boost.Test thread
+thread_local bool t_deferBoostErrors = false;
+thread_local size_t t_deferredBoostErrors = 0;
+
+// Key of the test in the failed tests map
+string failedTestKey(string const& _testName)
+{
+    return clientErrorPrefix() + _testName;
+}
+
+// Helpers of all threads that ever called get(). Nodes are only pushed to the front and never
+// removed, so the list is walked without a lock. A helper outlives its thread: errors of the
+// finished workers are collected at the end of the test folder. When a thread exits its node
+// goes to the free list and is taken by the next new thread
+struct TestOutputHelper::HelperNode
+{
+    TestOutputHelper helper;
+    HelperNode* next = nullptr;
+    HelperNode* nextFree = nullptr;
+};
+std::atomic<TestOutputHelper::HelperNode*> TestOutputHelper::s_helpers(nullptr);
+std::mutex TestOutputHelper::s_freeHelpersMutex;
+TestOutputHelper::HelperNode* TestOutputHelper::s_freeHelpers = nullptr;
+
+// Node of the thread, returned to the free list by the destructor on thread exit. A helper with
+// a running test is kept for finisAllTestsManually()
+struct TestOutputHelper::HelperHolder
+{
+    HelperNode* node = nullptr;
+    ~HelperHolder()
+    {
+        if (!node || node->helper.m_isRunning)
+            return;
+        std::lock_guard<std::mutex> lock(s_freeHelpersMutex);
+        node->nextFree = s_freeHelpers;
+        s_freeHelpers = node;
+    }
+};
+
 TestOutputHelper& TestOutputHelper::get()
 {
-    std::lock_guard<std::mutex> lock(g_helperThreadMapMutex);
-    if (helperThreadMap.count(getThreadID()))
-        return helperThreadMap.at(getThreadID());
-    else
+    thread_local HelperHolder t_holder;
+    if (t_holder.node)
+        return t_holder.node->helper;
+
+    HelperNode* node = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(s_freeHelpersMutex);
+        if (s_freeHelpers)
+        {
+            node = s_freeHelpers;
+            s_freeHelpers = node->nextFree;
+        }
+    }
+    if (!node)
     {
-        TestOutputHelper instance;
-        helperThreadMap.emplace(std::make_pair(getThreadID(), std::move(instance)));
-        helperThreadMap.at(getThreadID()).initTest(0);
+        node = new HelperNode();
+        node->next = s_helpers.load();
+        while (!s_helpers.compare_exchange_weak(node->next, node))
+        {
+        }
     }
-    return helperThreadMap.at(getThreadID());
+    node->helper.initTest(0);
+    t_holder.node = node;
+    return node->helper;
+}
+
+size_t TestOutputHelper::errorCount() const
+{
+    std::lock_guard<std::mutex> lock(m_errorsMutex);
+    return m_errors.size();
 }
 
 bool TestOutputHelper::markError(std::string const& _message)
@@ -83,13 +154,18 @@ bool TestOutputHelper::markError(std::string const& _message)
 
     // Mark the error
     string const testDebugInfo = m_testInfo.errorDebug();
-    m_errors.push_back(_message + testDebugInfo);
+    string const clientPrefix = clientErrorPrefix();
+    {
+        std::lock_guard<std::mutex> lock(m_errorsMutex);
+        m_errors.push_back(clientPrefix + _message + testDebugInfo);
+    }
     if (testDebugInfo.empty())
         ETH_WARNING(TestOutputHelper::get().testName() + ", Message: " + _message +
                     ", has empty debugInfo! Missing debug Tesinfo for test step.");
     std::lock_guard<std::mutex> lock(g_failedTestsMap);
-    if (!s_failedTestsMap.count(TestOutputHelper::get().testName()))
-        s_failedTestsMap[TestOutputHelper::get().testName()] = testDebugInfo;
+    string const failedTest = failedTestKey(TestOutputHelper::get().testName());
+    if (!s_failedTestsMap.count(failedTest))
+        s_failedTestsMap[failedTest] = testDebugInfo;
     return true;
 }
 
@@ -97,12 +173,14 @@ bool TestOutputHelper::markError(std::string const& _message)
 // retesteth side
 void TestOutputHelper::unmarkLastError()
 {
-    if (m_errors.size())
-        m_errors.pop_back();
+    {
+        std::lock_guard<std::mutex> lock(m_errorsMutex);
+        if (m_errors.size())
+            m_errors.pop_back();
+    }
+    string const failedTest = failedTestKey(TestOutputHelper::get().testName());
     std::lock_guard<std::mutex> lock(g_failedTestsMap);
-    string const& tname = TestOutputHelper::get().testName();
-    if (s_failedTestsMap.count(tname))
-        s_failedTestsMap.erase(tname);
+    s_failedTestsMap.erase(failedTest);
 }
 
 void TestOutputHelper::setUnitTestExceptions(std::vector<std::string> const& _messages)
@@ -112,10 +190,8 @@ void TestOutputHelper::setUnitTestExceptions(std::vector<std::string> const& _me
 
 void TestOutputHelper::finisAllTestsManually()
 {
-    // thread safe?
-    std::lock_guard<std::mutex> lock(g_helperThreadMapMutex);
-    for (auto& helper : helperThreadMap)
-        helper.second.finishTest();
+    for (HelperNode* node = s_helpers.load(); node; node = node->next)
+        node->helper.finishTest();
 }
 
 void TestOutputHelper::initTest(size_t _maxTests)
@@ -153,6 +229,12 @@ void TestOutputHelper::registerTestRunSuccess()
     totalTestsRun++;
 }
 
+void TestOutputHelper::registerTestRunSkipped()
+{
+    std::lock_guard<std::mutex> lock(g_totalTestsRun);
+    totalTestsSkipped++;
+}
+
 void TestOutputHelper::showProgress()
 {
     m_currTest++;
@@ -193,15 +275,25 @@ void TestOutputHelper::finishTest()
 
 void TestOutputHelper::printBoostError()
 {
+    // Other clients tested at once report their errors when they finish
+    string const clientPrefix = clientErrorPrefix();
     size_t errorCount = 0;
-    std::lock_guard<std::mutex> lock(g_helperThreadMapMutex);
-    for (auto& test : helperThreadMap)
+    for (HelperNode* node = s_helpers.load(); node; node = node->next)
     {
-        TestOutputHelper& threadLocalHelper = test.second;
-        errorCount += threadLocalHelper.getErrors().size();
-        for (auto const& err : threadLocalHelper.getErrors())
+        std::lock_guard<std::mutex> lock(node->helper.m_errorsMutex);
+        vector<string>& errors = node->helper.m_errors;
+        vector<string> otherClientErrors;
+        for (auto const& err : errors)
+        {
+            if (err.compare(0, clientPrefix.size(), clientPrefix) != 0)
+            {
+                otherClientErrors.push_back(err);
+                continue;
+            }
+            errorCount++;
             ETH_STDERROR_MESSAGE("Error: " + err);
-        threadLocalHelper.resetErrors();
+        }
+        errors = otherClientErrors;
     }
     if (errorCount)
     {
@@ -209,67 +301,84 @@ void TestOutputHelper::printBoostError()
         ETH_STDERROR_MESSAGE(
             "TestOutputHelper detected " + toString(errorCount) + " errors during test execution!");
         std::lock_guard<std::mutex> lock(g_execTotalErrors);
-        BOOST_ERROR("");  // NOT THREAD SAFE !!!
         execTotalErrors += errorCount;
+        if (t_deferBoostErrors)
+            t_deferredBoostErrors += errorCount;
+        else
+            BOOST_ERROR("");  // NOT THREAD SAFE !!!
     }
     // helperThreadMap.clear(); !!! could not delete TestHelper from TestHelper destructor !!!
 }
 
+void TestOutputHelper::deferBoostErrors()
+{
+    t_deferBoostErrors = true;
+    t_deferredBoostErrors = 0;
+}
+
+size_t TestOutputHelper::takeDeferredBoostErrors()
+{
+    t_deferBoostErrors = false;
+    return t_deferredBoostErrors;
+}
+
 bool TestOutputHelper::isAllTestsFinished()
 {
     std::lock_guard<std::mutex> lock(g_numberOfRunningTests);
     return numberOfRunningTests <= 0;
 }
 
-void TestOutputHelper::printTestExecStats()
+// Execution stats of this run as an object, also written as the --shard result file
+static DataObject collectExecStats()
 {
-    checkUnfinishedTestFolders();
-    if (Options::get().exectimelog)
-    {
-        std::lock_guard<std::mutex> lock(g_execTimeResults);
-        int totalTime = 0;
-        std::cout << std::left;
-        std::sort(execTimeResults.begin(), execTimeResults.end(), [](execTimeName _a, execTimeName _b) { return (_b.first < _a.first); });
-        for (size_t i = 0; i < execTimeResults.size(); i++)
-            totalTime += execTimeResults[i].first;
-        std::cout << std::endl << "*** Execution time stats" << std::endl;
-        {
-            std::lock_guard<std::mutex> lock2(g_totalTestsRun);
-            std::cout << setw(45) << "Total Tests: " << setw(25)
-                      << "     : " + toString(totalTestsRun) << "\n";
-        }
-        std::cout << setw(45) << "Total Time: " << setw(25) << "     : " + toString(totalTime) << "\n";
-        for (size_t i = 0; i < execTimeResults.size(); i++)
-            std::cout << setw(45) << execTimeResults[i].second << setw(25) << " time: " + toString(execTimeResults[i].first) << "\n";
-    }
-    else
+    DataObject stats;
+    Options const& opt = Options::get();
+    if (opt.shardCount)
+        stats["shard"] = toString(opt.shardIndex) + "/" + toString(opt.shardCount);
     {
         std::lock_guard<std::mutex> lock(g_totalTestsRun);
-        string message = "*** Total Tests Run: " + toString(totalTestsRun) + "\n";
-        if (totalTestsRun > 0)
-            ETH_STDOUT_MESSAGE(message);
-        else
-            ETH_STDERROR_MESSAGE(message);
+        stats["totalTestsRun"] = totalTestsRun;
+        stats["skippedTestFiles"] = totalTestsSkipped;
     }
-
-    bool wereExecErrors = false;
     {
         std::lock_guard<std::mutex> lock(g_execTotalErrors);
-        if (execTotalErrors)
-        {
-            wereExecErrors = true;
-            ETH_STDERROR_MESSAGE("\n--------");
-            ETH_STDERROR_MESSAGE("*** TOTAL ERRORS DETECTED: " + toString(execTotalErrors) +
-                                 " errors during all test execution!");
-            ETH_STDERROR_MESSAGE("--------");
-        }
+        stats["totalErrors"] = execTotalErrors;
     }
+    stats["transactionSignatures"] = (int)scheme_transaction::signaturesPerformed();
+    stats["transactionSignatureCacheHits"] = (int)scheme_transaction::signedTransactionHits();
 
-    if (wereExecErrors)
+    // milliseconds, DataObject has no floating point type
+    stats["execTimes"] = DataObject(DataType::Object);
+    {
+        std::lock_guard<std::mutex> lock(g_execTimeResults);
+        for (auto const& res : execTimeResults)
+            stats["execTimes"][res.second] = (int)(res.first * 1000);
+    }
+    stats["failedTests"] = DataObject(DataType::Object);
     {
         std::lock_guard<std::mutex> lock(g_failedTestsMap);
         for (auto const& error : s_failedTestsMap)
-            std::cout << "info:" << error.second << std::endl;
+            stats["failedTests"][error.first] = error.second;
+    }
+    return stats;
+}
+
+void TestOutputHelper::printTestExecStats()
+{
+    checkUnfinishedTestFolders();
+    DataObject const stats = collectExecStats();
+    printExecStats(stats, Options::get().exectimelog);
+    savePhaseTrace();
+
+    Options const& opt = Options::get();
+    if (opt.shardCount)
+    {
+        fs::path const resultFile = opt.shardResultFile.empty() ?
+                                        fs::path("shard_" + toString(opt.shardIndex) + "_of_" +
+                                                 toString(opt.shardCount) + ".json") :
+                                        fs::path(opt.shardResultFile);
+        writeFile(resultFile, asBytes(stats.asJson()));
+        ETH_STDOUT_MESSAGE("Shard result: " + resultFile.string());
     }
 
     {
@@ -283,9 +392,62 @@ void TestOutputHelper::printTestExecStats()
     }
 }
 
-std::string TestOutputHelper::getThreadID()
+void TestOutputHelper::printExecStats(DataObject const& _stats, bool _timeStats)
+{
+    int const totalTests = _stats.atKey("totalTestsRun").asInt();
+    if (_timeStats)
+    {
+        std::vector<execTimeName> execTimes;
+        for (auto const& time : _stats.atKey("execTimes").getSubObjects())
+            execTimes.push_back(execTimeName(time.asInt() / 1000.0, time.getKey()));
+        int totalTime = 0;
+        std::cout << std::left;
+        std::sort(execTimes.begin(), execTimes.end(), [](execTimeName _a, execTimeName _b) { return (_b.first < _a.first); });
+        for (size_t i = 0; i < execTimes.size(); i++)
+            totalTime += execTimes[i].first;
+        std::cout << std::endl << "*** Execution time stats" << std::endl;
+        std::cout << setw(45) << "Total Tests: " << setw(25)
+                  << "     : " + toString(totalTests) << "\n";
+        std::cout << setw(45) << "Total Time: " << setw(25) << "     : " + toString(totalTime) << "\n";
+        std::cout << setw(45) << "Transaction signatures: " << setw(25)
+                  << "     : " + toString(_stats.atKey("transactionSignatures").asInt()) << "\n";
+        std::cout << setw(45) << "Transaction signature cache hits: " << setw(25)
+                  << "     : " + toString(_stats.atKey("transactionSignatureCacheHits").asInt())
+                  << "\n";
+        for (size_t i = 0; i < execTimes.size(); i++)
+            std::cout << setw(45) << execTimes[i].second << setw(25) << " time: " + toString(execTimes[i].first) << "\n";
+    }
+    else
+    {
+        string message = "*** Total Tests Run: " + toString(totalTests) + "\n";
+        if (totalTests > 0)
+            ETH_STDOUT_MESSAGE(message);
+        else
+            ETH_STDERROR_MESSAGE(message);
+    }
+
+    if (_stats.count("skippedTestFiles") && _stats.atKey("skippedTestFiles").asInt() > 0)
+        ETH_STDOUT_MESSAGE("*** Test files completed before (--incremental, --resume): " +
+                           toString(_stats.atKey("skippedTestFiles").asInt()));
+
+    int const totalErrors = _stats.atKey("totalErrors").asInt();
+    if (totalErrors)
+    {
+        ETH_STDERROR_MESSAGE("\n--------");
+        ETH_STDERROR_MESSAGE("*** TOTAL ERRORS DETECTED: " + toString(totalErrors) +
+                             " errors during all test execution!");
+        ETH_STDERROR_MESSAGE("--------");
+        for (auto const& error : _stats.atKey("failedTests").getSubObjects())
+            std::cout << "info:" << error.asString() << std::endl;
+    }
+}
+
+
+size_t TestOutputHelper::getThreadID()
 {
-    return toString(std::this_thread::get_id());
+    static std::atomic<size_t> s_lastThreadID(0);
+    thread_local size_t const t_threadID = ++s_lastThreadID;
+    return t_threadID;
 }
 
 // check if a boost path contain no test files
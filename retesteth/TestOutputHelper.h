@@ -19,9 +19,12 @@
  */
 
 #pragma once
+#include <dataObject/DataObject.h>
 #include <libdevcore/CommonData.h>
 #include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <mutex>
 #include <vector>
 
 namespace test
@@ -92,6 +95,7 @@ public:
     }
 
     std::vector<std::string> const& getErrors() const { return m_errors;}
+    size_t errorCount() const;
     void resetErrors() { m_errors.clear(); }
     void setCurrentTestFile(boost::filesystem::path const& _name) { m_currentTestFileName = _name; }
     void setCurrentTestName(std::string const& _name) { m_currentTestName = _name; }
@@ -100,11 +104,20 @@ public:
     std::string const& testName() const { return m_currentTestName; }
     boost::filesystem::path const& testFile() const { return m_currentTestFileName; }
     static void printTestExecStats();
+    // Print totals and failed tests of the stats object (this run or merged --shard results)
+    static void printExecStats(dataobject::DataObject const& _stats, bool _timeStats);
     static bool isAllTestsFinished();
+
+    // Errors of the tests finished on this thread are counted instead of raising BOOST_ERROR,
+    // takeDeferredBoostErrors() returns the count and stops counting
+    static void deferBoostErrors();
+    static size_t takeDeferredBoostErrors();
     static void registerTestRunSuccess();
+    // Test file that passed or was filled in a previous run with the same inputs
+    static void registerTestRunSkipped();
 
-    /// get string representation of current threadID
-    static std::string getThreadID();
+    /// id of the current thread, unique for the process lifetime (never reused by a new thread)
+    static size_t getThreadID();
 
     // Mark the _folderName as executed for a given _suitePath (to filler files)
     static void markTestFolderAsFinished(
@@ -113,6 +126,11 @@ public:
 private:
     TestOutputHelper() {}
     void printBoostError();
+    struct HelperNode;
+    struct HelperHolder;
+    static std::atomic<HelperNode*> s_helpers;
+    static std::mutex s_freeHelpersMutex;
+    static HelperNode* s_freeHelpers;
 
 private:
     dev::Timer m_timer;
@@ -123,6 +141,7 @@ private:
     bool m_isRunning;
     boost::filesystem::path m_currentTestFileName;
     std::vector<std::string> m_errors; //flag errors for triggering boost erros after all thread finished
+    mutable std::mutex m_errorsMutex;  // m_errors are collected by the thread that finishes the test
     std::vector<std::string> m_expected_UnitTestExceptions;  // expect following errors
 };
 
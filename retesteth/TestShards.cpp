@@ -0,0 +1,156 @@
+#include <dataObject/ConvertFile.h>
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/SHA3.h>
+#include <retesteth/EthChecks.h>
+#include <retesteth/Options.h>
+#include <retesteth/TestHelper.h>
+#include <retesteth/TestOutputHelper.h>
+#include <retesteth/TestShards.h>
+#include <retesteth/TestTimings.h>
+#include <algorithm>
+#include <map>
+
+using namespace std;
+
+namespace
+{
+// Shard key does not depend on the test path of the machine
+string shardKey(fs::path const& _file)
+{
+    return fs::relative(_file, test::getTestPath()).string();
+}
+
+void addInt(DataObject& _obj, string const& _key, int _value)
+{
+    if (_obj.count(_key))
+        _obj[_key].setInt(_obj.atKey(_key).asInt() + _value);
+    else
+        _obj[_key] = _value;
+}
+}  // namespace
+
+namespace test
+{
+size_t shardOfTest(string const& _key, size_t _shardCount)
+{
+    dev::h256 const hash = dev::sha3(_key);
+    uint64_t value = 0;
+    for (size_t i = 0; i < 8; i++)
+        value = (value << 8) | hash[i];
+    return value % max<size_t>(1, _shardCount);
+}
+
+vector<size_t> balanceShards(
+    vector<string> const& _keys, vector<double> const& _estimates, size_t _shardCount)
+{
+    vector<size_t> order;
+    for (size_t i = 0; i < _keys.size(); i++)
+        order.push_back(i);
+    std::sort(order.begin(), order.end(), [&_keys, &_estimates](size_t _a, size_t _b) {
+        if (_estimates.at(_a) != _estimates.at(_b))
+            return _estimates.at(_a) > _estimates.at(_b);
+        return _keys.at(_a) < _keys.at(_b);
+    });
+
+    vector<double> shardLoad(max<size_t>(1, _shardCount), 0);
+    vector<size_t> shards(_keys.size(), 0);
+    for (size_t i : order)
+    {
+        size_t const shard =
+            std::min_element(shardLoad.begin(), shardLoad.end()) - shardLoad.begin();
+        shardLoad.at(shard) += _estimates.at(i);
+        shards.at(i) = shard;
+    }
+    return shards;
+}
+
+vector<fs::path> selectShardFiles(vector<fs::path> const& _files)
+{
+    Options const& opt = Options::get();
+    if (opt.shardCount == 0)
+        return _files;
+
+    vector<string> keys;
+    for (auto const& file : _files)
+        keys.push_back(shardKey(file));
+
+    vector<size_t> shards;
+    if (opt.shardbalance)
+    {
+        // Timings are taken for the first client, all shards must see the same timings file
+        string const configName = Options::getDynamicOptions().getClientConfigs().at(0).getName();
+        vector<string> timingKeys;
+        vector<uintmax_t> fileSizes;
+        for (auto const& file : _files)
+        {
+            timingKeys.push_back(TestTimings::makeKey(configName, file));
+            boost::system::error_code ec;
+            uintmax_t const size = fs::file_size(file, ec);
+            fileSizes.push_back(ec ? 0 : size);
+        }
+        shards = balanceShards(
+            keys, TestTimings::get().estimate(timingKeys, fileSizes), opt.shardCount);
+    }
+    else
+        for (auto const& key : keys)
+            shards.push_back(shardOfTest(key, opt.shardCount));
+
+    vector<fs::path> shardFiles;
+    for (size_t i = 0; i < _files.size(); i++)
+        if (shards.at(i) == opt.shardIndex - 1)
+            shardFiles.push_back(_files.at(i));
+    ETH_LOG("Shard " + toString(opt.shardIndex) + "/" + toString(opt.shardCount) + ": " +
+                toString(shardFiles.size()) + " of " + toString(_files.size()) + " test files",
+        3);
+    return shardFiles;
+}
+
+DataObject mergeShardResults(vector<DataObject> const& _shardResults)
+{
+    DataObject merged;
+    merged["shards"] = 0;
+    merged["totalTestsRun"] = 0;
+    merged["totalErrors"] = 0;
+    merged["transactionSignatures"] = 0;
+    merged["transactionSignatureCacheHits"] = 0;
+    merged["skippedTestFiles"] = 0;
+    merged["execTimes"] = DataObject(DataType::Object);
+    merged["failedTests"] = DataObject(DataType::Object);
+    for (auto const& shard : _shardResults)
+    {
+        addInt(merged, "shards", 1);
+        for (auto const& field : {"totalTestsRun", "totalErrors", "transactionSignatures"})
+            addInt(merged, field, shard.atKey(field).asInt());
+        for (auto const& field : {"skippedTestFiles", "transactionSignatureCacheHits"})
+            if (shard.count(field))
+                addInt(merged, field, shard.atKey(field).asInt());
+
+        // the same test case is executed by every shard on its part of the files
+        for (auto const& time : shard.atKey("execTimes").getSubObjects())
+            addInt(merged["execTimes"], time.getKey(), time.asInt());
+        for (auto const& failed : shard.atKey("failedTests").getSubObjects())
+            if (!merged.atKey("failedTests").count(failed.getKey()))
+                merged["failedTests"][failed.getKey()] = failed.asString();
+    }
+    return merged;
+}
+
+int printMergedShardResults(vector<string> const& _files)
+{
+    vector<DataObject> shardResults;
+    for (auto const& file : _files)
+    {
+        ETH_FAIL_REQUIRE_MESSAGE(fs::exists(file), "Shard result file not found: " + file);
+        shardResults.push_back(ConvertJsoncppStringToData(dev::contentsString(file)));
+    }
+
+    DataObject const merged = mergeShardResults(shardResults);
+    ETH_STDOUT_MESSAGE("*** Merged " + toString(merged.atKey("shards").asInt()) + " shards");
+    TestOutputHelper::printExecStats(merged, merged.atKey("execTimes").getSubObjects().size() > 0);
+    bool const success = merged.atKey("totalErrors").asInt() == 0 &&
+                         (merged.atKey("totalTestsRun").asInt() > 0 ||
+                             merged.atKey("skippedTestFiles").asInt() > 0);
+    return success ? 0 : 1;
+}
+
+}  // namespace test
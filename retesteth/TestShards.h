@@ -0,0 +1,31 @@
+#pragma once
+#include <dataObject/DataObject.h>
+#include <boost/filesystem.hpp>
+#include <string>
+#include <vector>
+
+using namespace dataobject;
+namespace fs = boost::filesystem;
+namespace test
+{
+// Deterministic split of the test files between retesteth instances (--shard i/N)
+// Every instance computes the same assignment, so shards could run on different machines
+
+// Shard [0, _shardCount) of the test by the stable hash of its key
+size_t shardOfTest(std::string const& _key, size_t _shardCount);
+
+// Shard of each test with duration weighted balancing (--shardbalance): the longest tests go
+// first, each to the least loaded shard. Same _estimates give the same assignment
+std::vector<size_t> balanceShards(std::vector<std::string> const& _keys,
+    std::vector<double> const& _estimates, size_t _shardCount);
+
+// Filler files of the folder that belong to this instance shard
+std::vector<fs::path> selectShardFiles(std::vector<fs::path> const& _files);
+
+// Combine the shard result files into one summary with the totals of all shards
+DataObject mergeShardResults(std::vector<DataObject> const& _shardResults);
+
+// Read, merge and print shard result files (--mergeshards). Returns process exit code
+int printMergedShardResults(std::vector<std::string> const& _files);
+
+}  // namespace test
@@ -26,12 +26,18 @@
 #include <retesteth/ExitHandler.h>
 #include <retesteth/Options.h>
 #include <retesteth/TestHelper.h>
+#include <retesteth/TestJournal.h>
 #include <retesteth/TestOutputHelper.h>
+#include <retesteth/TestShards.h>
 #include <retesteth/TestSuite.h>
+#include <retesteth/TestTimings.h>
+#include <retesteth/TestTrace.h>
+#include <retesteth/WorkerPool.h>
 #include <retesteth/session/RPCSession.h>
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <atomic>
 #include <string>
-#include <thread>
 
 
 using namespace std;
@@ -48,6 +54,7 @@ struct TestFileData
 
 TestFileData readTestFile(fs::path const& _testFileName)
 {
+    PhaseTimer timer(TestPhase::Parse);
     TestFileData testData;
     if (_testFileName.extension() == ".json")
         testData.data = test::readJsonData(_testFileName, string(), true);
@@ -134,8 +141,28 @@ void addClientInfo(
 
 void checkFillerHash(fs::path const& _compiledTest, fs::path const& _sourceTest)
 {
-    dataobject::DataObject v = test::readJsonData(_compiledTest, "_info");
-    TestFileData fillerData = readTestFile(_sourceTest);
+    PhaseTimer timer(TestPhase::HashCheck);
+    TestOutputHelper::get().setCurrentTestInfo(TestInfo("CheckFillers", _compiledTest.stem().string()));
+    dataobject::DataObject v;
+    TestFileData fillerData;
+    try
+    {
+        v = test::readJsonData(_compiledTest, "_info");
+        fillerData = readTestFile(_sourceTest);
+    }
+    catch (test::BaseEthException const&)
+    {
+        // error message is stored at TestOutputHelper
+        TestOutputHelper::get().setCurrentTestInfo(TestInfo());
+        return;
+    }
+    catch (std::exception const& _ex)
+    {
+        ETH_MARK_ERROR("Failed to read " + _compiledTest.string() + ": " + _ex.what());
+        TestOutputHelper::get().setCurrentTestInfo(TestInfo());
+        return;
+    }
+
     for (auto const& i: v.getSubObjects())
     {
         try
@@ -159,47 +186,55 @@ void checkFillerHash(fs::path const& _compiledTest, fs::path const& _sourceTest)
             continue;
         }
     }
+    TestOutputHelper::get().setCurrentTestInfo(TestInfo());
+}
+
+// Threads for the tests of the client config run by this thread (runFunctionForAllClients)
+thread_local size_t s_clientThreadCount = 0;
+
+// Called on the worker thread when the pool is destroyed. Let the next pool reuse the session
+void releaseWorkerSession()
+{
+    size_t const id = TestOutputHelper::getThreadID();
+    if (RPCSession::sessionStatus(id) != RPCSession::NotExist)
+        RPCSession::sessionEnd(id, RPCSession::SessionStatus::Available);
 }
 
-void joinThreads(vector<thread>& _threadVector, bool _all)
+// Order test files for the dispatch and return their expected durations in the same order
+// With --longestfirst the longest tests go first, so they do not stretch the end of the run
+vector<double> orderByExpectedTime(vector<fs::path>& _files, vector<string>& _timingKeys)
 {
-    if (_all)
+    string const configName = Options::getDynamicOptions().getCurrentConfig().getName();
+    vector<uintmax_t> fileSizes;
+    for (auto const& file : _files)
     {
-        for (auto& th : _threadVector)
-        {
-            string id = toString(th.get_id());
-            th.join();
-            // A thread with exception thrown still being joined here!
-            RPCSession::sessionEnd(id, RPCSession::SessionStatus::Available);
-        }
-        _threadVector.clear();
-        if (ExitHandler::receivedExitSignal())
-        {
-            // if one of the tests threads failed with fatal exception
-            // stop retesteth execution
-            TestOutputHelper::get().finishTest();
-            ExitHandler::doExit();
-        }
-        return;  // otherwise continue test execution
+        _timingKeys.push_back(TestTimings::makeKey(configName, file));
+        boost::system::error_code ec;
+        uintmax_t const size = fs::file_size(file, ec);
+        fileSizes.push_back(ec ? 0 : size);
     }
-
-    bool finished = false;
-    while (!finished)
+    vector<double> estimates = TestTimings::get().estimate(_timingKeys, fileSizes);
+    if (!Options::get().longestfirst)
+        return estimates;
+
+    vector<size_t> order;
+    for (size_t i = 0; i < _files.size(); i++)
+        order.push_back(i);
+    std::stable_sort(order.begin(), order.end(),
+        [&estimates](size_t _a, size_t _b) { return estimates.at(_a) > estimates.at(_b); });
+
+    vector<fs::path> files;
+    vector<string> timingKeys;
+    vector<double> orderedEstimates;
+    for (size_t i : order)
     {
-        for (vector<thread>::iterator it = _threadVector.begin(); it != _threadVector.end(); it++)
-        {
-            finished =
-                (RPCSession::sessionStatus(toString((*it).get_id())) == RPCSession::HasFinished);
-            if (finished)
-            {
-                string id = toString((*it).get_id());
-                (*it).join();
-                RPCSession::sessionEnd(id, RPCSession::SessionStatus::Available);
-                _threadVector.erase(it);
-                return;
-            }
-        }
+        files.push_back(_files.at(i));
+        timingKeys.push_back(_timingKeys.at(i));
+        orderedEstimates.push_back(estimates.at(i));
     }
+    _files = files;
+    _timingKeys = timingKeys;
+    return orderedEstimates;
 }
 }
 
@@ -230,7 +265,8 @@ void TestSuite::runTestWithoutFiller(boost::filesystem::path const& _file) const
     }
 }
 
-string TestSuite::checkFillerExistance(string const& _testFolder) const
+string TestSuite::checkFillerExistance(
+    string const& _testFolder, FillerHashChecks& _hashChecks) const
 {
     test::Options const& opt = test::Options::get();
     string const testNameFilter = opt.singleTestName.empty() ? string() : opt.singleTestName;
@@ -311,21 +347,21 @@ string TestSuite::checkFillerExistance(string const& _testFolder) const
         {
             if (Options::get().filltests == false)  // If we are filling the test it is probably
                                                     // outdated/being updated. no need to check.
-                checkFillerHash(file, expectedFillerName);
+                _hashChecks.push_back({file, expectedFillerName});
             if (!testNameFilter.empty())
                 return testNameFilter + c_fillerPostf;
         }
         if (fs::exists(expectedFillerName2))
         {
             if (Options::get().filltests == false)
-                checkFillerHash(file, expectedFillerName2);
+                _hashChecks.push_back({file, expectedFillerName2});
             if (!testNameFilter.empty())
                 return testNameFilter + c_fillerPostf;
         }
         if (fs::exists(expectedCopierName))
         {
             if (Options::get().filltests == false)
-                checkFillerHash(file, expectedCopierName);
+                _hashChecks.push_back({file, expectedCopierName});
             if (!testNameFilter.empty())
                 return testNameFilter + c_copierPostf;
         }
@@ -347,9 +383,10 @@ void TestSuite::runAllTestsInFolder(string const& _testFolder) const
 
     // check that destination folder test files has according Filler file in src folder
     string filter;
+    FillerHashChecks hashChecks;
     try
     {
-        filter = checkFillerExistance(_testFolder);
+        filter = checkFillerExistance(_testFolder, hashChecks);
     }
     catch (std::exception const&)
     {
@@ -360,40 +397,80 @@ void TestSuite::runAllTestsInFolder(string const& _testFolder) const
 
     // run all tests
     AbsoluteFillerPath fillerPath = getFullPathFiller(_testFolder);
-    vector<fs::path> const files = test::getFiles(fillerPath.path(), {".json", ".yml"}, filter);
+    vector<fs::path> const files =
+        selectShardFiles(test::getFiles(fillerPath.path(), {".json", ".yml"}, filter));
+
+    // Filler hashes are verified once, by the workers of the first client next to its tests
+    std::atomic<bool> hashChecksQueued(false);
 
     // repeat this part for all connected clients
-    auto thisPart = [this, &files, &_testFolder]() {
+    auto thisPart = [this, &files, &_testFolder, &hashChecks, &hashChecksQueued]() {
         auto& testOutput = test::TestOutputHelper::get();
-        vector<thread> threadVector;
         testOutput.initTest(files.size());
-        for (auto const& file : files)
+
+        // If debugging, already there is an open instance of a client.
+        // Only one thread allowed to connect to it;
+        size_t maxAllowedThreads = s_clientThreadCount ? s_clientThreadCount : Options::get().threadCount;
+        ClientConfig const& currConfig = Options::get().getDynamicOptions().getCurrentConfig();
+        Socket::SocketType socType = currConfig.getSocketType();
+        if (socType == Socket::SocketType::IPCDebug)
+            maxAllowedThreads = 1;
+        // If connecting to TCP sockets. Max threads are limited with tcp ports provided
+        if (socType == Socket::SocketType::TCP)
+            maxAllowedThreads = min(maxAllowedThreads, currConfig.getAddressObject().getSubObjects().size());
+
+        vector<fs::path> orderedFiles = files;
+        vector<string> timingKeys;
+        vector<double> const estimates = orderByExpectedTime(orderedFiles, timingKeys);
+        size_t const threadCount = max<size_t>(1, min(maxAllowedThreads, files.size()));
+        Timer folderTimer;
         {
-            if (ExitHandler::receivedExitSignal())
+            // Workers are bound to the sessions of the current config for the pool lifetime
+            WorkerPool pool(threadCount,
+                [&currConfig]() { Options::getDynamicOptions().setCurrentConfig(currConfig); },
+                releaseWorkerSession);
+            // The first threadCount tests start right away, then a hash check follows each test
+            bool const queueHashChecks = !hashChecksQueued.exchange(true);
+            auto nextHashCheck = hashChecks.begin();
+            auto queueHashCheck = [&pool, &nextHashCheck]() {
+                auto const& check = *nextHashCheck++;
+                pool.addTask([&check]() { checkFillerHash(check.first, check.second); }, false);
+            };
+            for (size_t i = 0; i < orderedFiles.size(); i++)
             {
-                testOutput.finishTest();
-                break;
+                fs::path const& file = orderedFiles.at(i);
+                string const& timingKey = timingKeys.at(i);
+                pool.addTask([this, &_testFolder, &file, &timingKey]() {
+                    Timer testTimer;
+                    executeTest(_testFolder, file);
+                    if (!ExitHandler::receivedExitSignal())
+                        TestTimings::get().add(timingKey, testTimer.elapsed());
+                });
+                if (queueHashChecks && i + 1 >= threadCount && nextHashCheck != hashChecks.end())
+                    queueHashCheck();
             }
-            testOutput.showProgress();
-
-            // If debugging, already there is an open instance of a client.
-            // Only one thread allowed to connect to it;
-            size_t maxAllowedThreads = Options::get().threadCount;
-            ClientConfig const& currConfig = Options::get().getDynamicOptions().getCurrentConfig();
-            Socket::SocketType socType = currConfig.getSocketType();
-            if (socType == Socket::SocketType::IPCDebug)
-                maxAllowedThreads = 1;
-            // If connecting to TCP sockets. Max threads are limited with tcp ports provided
-            if (socType == Socket::SocketType::TCP)
-                maxAllowedThreads = min(maxAllowedThreads, currConfig.getAddressObject().getSubObjects().size());
-
-            if (threadVector.size() == maxAllowedThreads)
-                joinThreads(threadVector, false);
-            thread testThread(&TestSuite::executeTest, this, _testFolder, file);
-            threadVector.push_back(std::move(testThread));
+            while (queueHashChecks && nextHashCheck != hashChecks.end())
+                queueHashCheck();
+
+            pool.wait([&pool, &testOutput]() {
+                testOutput.showProgress();
+                if (ExitHandler::receivedExitSignal())
+                    pool.cancel();
+            });
         }
-        joinThreads(threadVector, true);
+        TestTimings::get().save();
+        if (Options::get().longestfirst || Options::get().exectimelog)
+            ETH_STDOUT_MESSAGE("Predicted makespan: " +
+                               toString(predictMakespan(estimates, threadCount)) +
+                               "s, actual: " + toString(folderTimer.elapsed()) + "s");
+
         testOutput.finishTest();
+        if (ExitHandler::receivedExitSignal())
+        {
+            // if one of the tests threads failed with fatal exception
+            // stop retesteth execution
+            ExitHandler::doExit();
+        }
     };
     runFunctionForAllClients(thisPart);
 }
@@ -401,15 +478,50 @@ void TestSuite::runAllTestsInFolder(string const& _testFolder) const
 
 void TestSuite::runFunctionForAllClients(std::function<void()> _func)
 {
-    for (auto const& config : Options::getDynamicOptions().getClientConfigs())
+    auto const& configs = Options::getDynamicOptions().getClientConfigs();
+    size_t const threadCount = Options::get().threadCount;
+    if (configs.size() > 1 && threadCount >= configs.size())
+    {
+        // Run all clients at once, each on its share of the -j thread budget
+        WorkerPool clientsPool(configs.size());
+        vector<size_t> clientErrors(configs.size(), 0);
+        for (size_t i = 0; i < configs.size(); i++)
+        {
+            ClientConfig const& config = configs.at(i);
+            size_t const clientThreads =
+                threadCount / configs.size() + (i < threadCount % configs.size() ? 1 : 0);
+            clientsPool.addTask([&_func, &config, &clientErrors, i, clientThreads]() {
+                Options::getDynamicOptions().setCurrentConfig(config);
+                s_clientThreadCount = clientThreads;
+                ETH_STDOUT_MESSAGE("Running tests for config '" + config.getName() + "' " +
+                                   toString(config.getId().id()) + " on " +
+                                   toString(clientThreads) + " threads");
+                TestOutputHelper::deferBoostErrors();
+                _func();
+                clientErrors.at(i) = TestOutputHelper::takeDeferredBoostErrors();
+            });
+        }
+        clientsPool.wait();
+        for (size_t i = 0; i < configs.size(); i++)
+            if (clientErrors.at(i))
+                BOOST_ERROR("Client config '" + configs.at(i).getName() + "': " +
+                            toString(clientErrors.at(i)) + " errors");
+
+        // Disconnect threads from the clients
+        RPCSession::clear();
+        return;
+    }
+
+    for (auto const& config : configs)
     {
         Options::getDynamicOptions().setCurrentConfig(config);
+        s_clientThreadCount = threadCount;
         std::cout << "Running tests for config '" << config.getName() << "' " << config.getId().id()
                   << std::endl;
         _func();
 
         // Disconnect threads from the client
-        if (Options::getDynamicOptions().getClientConfigs().size() > 1)
+        if (configs.size() > 1)
             RPCSession::clear();
     }
 }
@@ -442,6 +554,8 @@ void TestSuite::executeTest(string const& _testFolder, fs::path const& _testFile
 {
     RPCSession::sessionStart(TestOutputHelper::getThreadID());
     TestOutputHelper::get().setCurrentTestFile(_testFileName);
+    TestOutputHelper::get().setCurrentTestName(string());
+    PhaseTimer fileTimer(TestPhase::File);
     fs::path const boostRelativeTestPath = fs::relative(_testFileName, getTestPath());
     string testname = _testFileName.stem().string();
     bool isCopySource = false;
@@ -471,8 +585,24 @@ void TestSuite::executeTest(string const& _testFolder, fs::path const& _testFile
 
     bool wasErrors = false;
     TestSuiteOptions opt;
+    string filledKey;
+    size_t const errorsBefore = TestOutputHelper::get().errorCount();
     if (Options::get().filltests)
     {
+        // Completed fills are journaled, so an interrupted fill continues with --resume
+        filledKey = filledTestKey(_testFileName);
+        if (Options::get().resume)
+        {
+            string const filledEntry = filledTestEntry(filledKey, boostTestPath.path());
+            if (!filledEntry.empty() && filledTestsJournal().contains(filledEntry))
+            {
+                ETH_LOG("Skip " + testname + " (filled before)", 3);
+                TestOutputHelper::registerTestRunSkipped();
+                RPCSession::sessionEnd(TestOutputHelper::getThreadID(), RPCSession::SessionStatus::HasFinished);
+                return;
+            }
+        }
+
         TestFileData testData = readTestFile(_testFileName);
         if (isCopySource)
         {
@@ -480,6 +610,7 @@ void TestSuite::executeTest(string const& _testFolder, fs::path const& _testFile
             ETH_LOG(" TO " + boostTestPath.path().string(), 0);
             assert(_testFileName.string() != boostTestPath.path().string());
             addClientInfo(testData.data, boostRelativeTestPath, testData.hash);
+            PhaseTimer writeTimer(TestPhase::OutputWrite);
             writeFile(boostTestPath.path(), asBytes(testData.data.asJson()));
             ETH_FAIL_REQUIRE_MESSAGE(boost::filesystem::exists(boostTestPath.path().string()),
                 "Error when copying the test file!");
@@ -494,6 +625,7 @@ void TestSuite::executeTest(string const& _testFolder, fs::path const& _testFile
                 DataObject output = doTests(testData.data, opt);
                 // Add client info for all of the tests in output
                 addClientInfo(output, boostRelativeTestPath, testData.hash);
+                PhaseTimer writeTimer(TestPhase::OutputWrite);
                 writeFile(boostTestPath.path(), asBytes(output.asJson()));
             }
             catch (test::BaseEthException const&)
@@ -516,7 +648,23 @@ void TestSuite::executeTest(string const& _testFolder, fs::path const& _testFile
         try
         {
             TestOutputHelper::get().setCurrentTestFile(boostTestPath.path());
-            executeFile(boostTestPath.path());
+            Options const& options = Options::get();
+            string passedKey;
+            if (options.incremental || options.fullrun)
+                passedKey = passedTestKey(boostTestPath.path());
+
+            if (options.incremental && !options.fullrun && passedTestsJournal().contains(passedKey))
+            {
+                ETH_LOG("Skip " + testname + " (passed before)", 3);
+                TestOutputHelper::registerTestRunSkipped();
+            }
+            else
+            {
+                size_t const runErrorsBefore = TestOutputHelper::get().errorCount();
+                executeFile(boostTestPath.path());
+                if (!passedKey.empty() && TestOutputHelper::get().errorCount() == runErrorsBefore)
+                    passedTestsJournal().add(passedKey);
+            }
         }
         catch (test::BaseEthException const&)
         {
@@ -529,13 +677,25 @@ void TestSuite::executeTest(string const& _testFolder, fs::path const& _testFile
             RPCSession::sessionEnd(TestOutputHelper::getThreadID(), RPCSession::SessionStatus::HasFinished);
         }
     }
+
+    if (!filledKey.empty() && !wasErrors && TestOutputHelper::get().errorCount() == errorsBefore)
+    {
+        string const filledEntry = filledTestEntry(filledKey, boostTestPath.path());
+        if (!filledEntry.empty())
+            filledTestsJournal().add(filledEntry);
+    }
     RPCSession::sessionEnd(TestOutputHelper::getThreadID(), RPCSession::SessionStatus::HasFinished);
 }
 
 void TestSuite::executeFile(boost::filesystem::path const& _file) const
 {
     TestSuiteOptions opt;
-    doTests(test::readJsonData(_file), opt);
+    DataObject testData;
+    {
+        PhaseTimer timer(TestPhase::Parse);
+        testData = test::readJsonData(_file);
+    }
+    doTests(testData, opt);
 }
 
 }
@@ -32,7 +32,9 @@ class TestSuite
 private:
     // Execute Test.json file
     void executeFile(boost::filesystem::path const& _file) const;
-    std::string checkFillerExistance(std::string const& _testFolder) const;
+    // Compiled test and its source filler which hash is verified on the worker pool
+    typedef std::vector<std::pair<boost::filesystem::path, boost::filesystem::path>> FillerHashChecks;
+    std::string checkFillerExistance(std::string const& _testFolder, FillerHashChecks& _hashChecks) const;
     struct BoostPath
     {
         BoostPath(boost::filesystem::path _path) : m_path(_path) {}
@@ -0,0 +1,134 @@
+#include <dataObject/ConvertFile.h>
+#include <libdevcore/CommonIO.h>
+#include <retesteth/EthChecks.h>
+#include <retesteth/Options.h>
+#include <retesteth/TestHelper.h>
+#include <retesteth/TestTimings.h>
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+using namespace std;
+using namespace dataobject;
+
+namespace
+{
+// Timings are stored in milliseconds, DataObject has no floating point type
+std::map<string, double> readTimings(fs::path const& _file)
+{
+    std::map<string, double> timings;
+    if (!fs::exists(_file))
+        return timings;
+    try
+    {
+        DataObject const data = ConvertJsoncppStringToData(dev::contentsString(_file));
+        for (auto const& el : data.getSubObjects())
+            if (el.type() == DataType::Integer)
+                timings[el.getKey()] = el.asInt() / 1000.0;
+    }
+    catch (std::exception const& _ex)
+    {
+        ETH_WARNING("Failed to read test timings '" + _file.string() + "': " + _ex.what());
+    }
+    return timings;
+}
+
+// Seconds per byte used when there are no known tests to estimate from
+double const c_defaultSecondsPerByte = 1e-5;
+}  // namespace
+
+namespace test
+{
+TestTimings& TestTimings::get()
+{
+    static TestTimings instance(getRetestethDataDir() / "timings.json");
+    return instance;
+}
+
+TestTimings::TestTimings(fs::path const& _timingsPath) : m_timingsPath(_timingsPath)
+{
+    m_timings = readTimings(m_timingsPath);
+}
+
+string TestTimings::makeKey(string const& _configName, fs::path const& _testFile)
+{
+    return _configName + ":" + fs::relative(_testFile, getTestPath()).string();
+}
+
+void TestTimings::add(string const& _key, double _seconds)
+{
+    std::lock_guard<std::mutex> lock(m_timingsMutex);
+    m_timings[_key] = _seconds;
+    m_newTimings[_key] = _seconds;
+}
+
+vector<double> TestTimings::estimate(vector<string> const& _keys, vector<uintmax_t> const& _fileSizes)
+{
+    std::lock_guard<std::mutex> lock(m_timingsMutex);
+    double knownSeconds = 0;
+    uintmax_t knownBytes = 0;
+    for (size_t i = 0; i < _keys.size(); i++)
+    {
+        auto const it = m_timings.find(_keys.at(i));
+        if (it != m_timings.end())
+        {
+            knownSeconds += it->second;
+            knownBytes += _fileSizes.at(i);
+        }
+    }
+    double const secondsPerByte = knownBytes > 0 ? knownSeconds / knownBytes : c_defaultSecondsPerByte;
+
+    vector<double> estimates;
+    for (size_t i = 0; i < _keys.size(); i++)
+    {
+        auto const it = m_timings.find(_keys.at(i));
+        estimates.push_back(it != m_timings.end() ? it->second : _fileSizes.at(i) * secondsPerByte);
+    }
+    return estimates;
+}
+
+void TestTimings::save()
+{
+    std::lock_guard<std::mutex> lock(m_timingsMutex);
+    if (m_newTimings.empty())
+        return;
+
+    std::map<string, double> timings = readTimings(m_timingsPath);
+    for (auto const& el : m_newTimings)
+        timings[el.first] = el.second;
+    m_newTimings.clear();
+
+    DataObject data;
+    for (auto const& el : timings)
+        data[el.first] = (int)(el.second * 1000);
+
+    // write via rename so other retesteth instances never read half written file
+    // timings only order the next run, losing them must not fail the tests
+    try
+    {
+        dev::writeFile(m_timingsPath, data.asJson(), true);
+    }
+    catch (std::exception const& _ex)
+    {
+        ETH_WARNING("Failed to save test timings '" + m_timingsPath.string() + "': " + _ex.what());
+    }
+}
+
+double predictMakespan(vector<double> const& _durations, size_t _workers)
+{
+    // finish times of the workers, the earliest on top
+    priority_queue<double, vector<double>, greater<double>> workers;
+    for (size_t i = 0; i < max<size_t>(1, _workers); i++)
+        workers.push(0);
+    double makespan = 0;
+    for (double duration : _durations)
+    {
+        double const finish = workers.top() + duration;
+        workers.pop();
+        workers.push(finish);
+        makespan = max(makespan, finish);
+    }
+    return makespan;
+}
+
+}  // namespace test
@@ -0,0 +1,44 @@
+#pragma once
+#include <boost/filesystem.hpp>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace fs = boost::filesystem;
+namespace test
+{
+// Wall time of test files from the previous runs, stored in <datadir>/timings.json
+// Used to dispatch the longest tests first (--longestfirst)
+class TestTimings
+{
+public:
+    static TestTimings& get();
+
+    // Timings of the _timingsPath file, get() uses <datadir>/timings.json
+    explicit TestTimings(fs::path const& _timingsPath);
+
+    // Timings are kept per client config, the same test takes different time on different clients
+    static std::string makeKey(std::string const& _configName, fs::path const& _testFile);
+
+    void add(std::string const& _key, double _seconds);
+
+    // Expected seconds for each of the _keys. Tests without stored timings are estimated from
+    // _fileSizes with the average seconds per byte of the known tests
+    std::vector<double> estimate(
+        std::vector<std::string> const& _keys, std::vector<uintmax_t> const& _fileSizes);
+
+    // Merge the new timings into the file, other retesteth instances might have updated it
+    void save();
+
+private:
+    fs::path m_timingsPath;
+    std::mutex m_timingsMutex;
+    std::map<std::string, double> m_timings;
+    std::map<std::string, double> m_newTimings;
+};
+
+// Time to execute _durations in the given order on _workers, each job goes to the first free worker
+double predictMakespan(std::vector<double> const& _durations, size_t _workers);
+
+}  // namespace test
@@ -0,0 +1,241 @@
+#include <libdevcore/CommonIO.h>
+#include <retesteth/EthChecks.h>
+#include <retesteth/Options.h>
+#include <retesteth/TestOutputHelper.h>
+#include <retesteth/TestTrace.h>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+
+using namespace std;
+using namespace dataobject;
+
+namespace
+{
+// Events of one thread. Buffers are never removed, so events of the finished workers stay
+struct ThreadEvents
+{
+    std::mutex mutex;
+    vector<test::PhaseEvent> events;
+};
+std::mutex g_threadEventsMutex;
+vector<ThreadEvents*> s_threadEvents;
+
+ThreadEvents& threadEvents()
+{
+    thread_local ThreadEvents* t_events = nullptr;
+    if (!t_events)
+    {
+        t_events = new ThreadEvents();
+        std::lock_guard<std::mutex> lock(g_threadEventsMutex);
+        s_threadEvents.push_back(t_events);
+    }
+    return *t_events;
+}
+
+std::atomic<int> s_traceEnabled(-1);  // -1 not yet read from options
+
+// Captured at program start, events of all threads are relative to it
+std::chrono::steady_clock::time_point const g_traceStart = std::chrono::steady_clock::now();
+
+string jsonEscape(string const& _str)
+{
+    string escaped;
+    for (char c : _str)
+    {
+        if (c == '"' || c == '\\')
+            escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+}  // namespace
+
+namespace test
+{
+string phaseName(TestPhase _phase)
+{
+    switch (_phase)
+    {
+    case TestPhase::File:
+        return "file";
+    case TestPhase::Test:
+        return "test";
+    case TestPhase::Parse:
+        return "parse";
+    case TestPhase::HashCheck:
+        return "hashCheck";
+    case TestPhase::Compile:
+        return "compile";
+    case TestPhase::SetChainParams:
+        return "setChainParams";
+    case TestPhase::SendTransaction:
+        return "sendTransaction";
+    case TestPhase::Mine:
+        return "mine";
+    case TestPhase::StateFetch:
+        return "stateFetch";
+    case TestPhase::Compare:
+        return "compare";
+    case TestPhase::OutputWrite:
+        return "outputWrite";
+    }
+    return "unknown";
+}
+
+bool isPhaseTraceEnabled()
+{
+    int enabled = s_traceEnabled;
+    if (enabled == -1)
+    {
+        Options const& opt = Options::get();
+        enabled = !opt.phaselog.empty() || !opt.tracelog.empty();
+        s_traceEnabled = enabled;
+    }
+    return enabled;
+}
+
+void enablePhaseTrace(bool _enabled)
+{
+    s_traceEnabled = _enabled;
+}
+
+PhaseTimer::PhaseTimer(TestPhase _phase) : m_phase(_phase), m_enabled(isPhaseTraceEnabled())
+{
+    if (!m_enabled)
+        return;
+    TestOutputHelper const& helper = TestOutputHelper::get();
+    m_file = helper.testFile().filename().string();
+    m_test = helper.testName();
+    m_start = std::chrono::steady_clock::now();
+}
+
+PhaseTimer::~PhaseTimer()
+{
+    stop();
+}
+
+void PhaseTimer::stop()
+{
+    if (!m_enabled)
+        return;
+    m_enabled = false;
+    using namespace std::chrono;
+    steady_clock::time_point const end = steady_clock::now();
+    PhaseEvent event;
+    event.phase = m_phase;
+    event.file = m_file;
+    event.test = m_test;
+    event.threadID = TestOutputHelper::getThreadID();
+    event.startUs = duration_cast<microseconds>(m_start - g_traceStart).count();
+    event.durationUs = duration_cast<microseconds>(end - m_start).count();
+    recordPhase(event);
+}
+
+void recordPhase(PhaseEvent const& _event)
+{
+    ThreadEvents& buffer = threadEvents();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.events.push_back(_event);
+}
+
+vector<PhaseEvent> collectPhaseEvents()
+{
+    vector<PhaseEvent> events;
+    {
+        std::lock_guard<std::mutex> lock(g_threadEventsMutex);
+        for (ThreadEvents* buffer : s_threadEvents)
+        {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            events.insert(events.end(), buffer->events.begin(), buffer->events.end());
+        }
+    }
+    std::stable_sort(events.begin(), events.end(),
+        [](PhaseEvent const& _a, PhaseEvent const& _b) { return _a.startUs < _b.startUs; });
+    return events;
+}
+
+DataObject phaseSummary(vector<PhaseEvent> const& _events)
+{
+    // file => test => phase => microseconds
+    std::map<string, std::map<string, std::map<string, int64_t>>> totals;
+    for (auto const& event : _events)
+        totals[event.file][event.test][phaseName(event.phase)] += event.durationUs;
+
+    DataObject summary(DataType::Object);
+    for (auto const& file : totals)
+        for (auto const& test : file.second)
+        {
+            // file phase is recorded before the test name is known
+            string const testKey = test.first.empty() ? "_file" : test.first;
+            // milliseconds fit the int of DataObject for any realistic run
+            for (auto const& phase : test.second)
+                summary[file.first][testKey][phase.first] = (int)((phase.second + 500) / 1000);
+        }
+    return summary;
+}
+
+string phaseEventsCSV(vector<PhaseEvent> const& _events)
+{
+    std::ostringstream csv;
+    csv << "file,test,phase,thread,start_us,duration_us\n";
+    for (auto const& event : _events)
+        csv << event.file << "," << event.test << "," << phaseName(event.phase) << ","
+            << event.threadID << "," << event.startUs << "," << event.durationUs << "\n";
+    return csv.str();
+}
+
+string phaseChromeTrace(vector<PhaseEvent> const& _events)
+{
+    // Complete events ("ph":"X") with the worker thread as a track
+    std::ostringstream trace;
+    std::set<size_t> threads;
+    trace << "{\"traceEvents\":[";
+    bool first = true;
+    for (auto const& event : _events)
+    {
+        threads.insert(event.threadID);
+        trace << (first ? "" : ",") << "\n{\"name\":\"" << phaseName(event.phase)
+              << "\",\"cat\":\"retesteth\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadID
+              << ",\"ts\":" << event.startUs << ",\"dur\":" << event.durationUs
+              << ",\"args\":{\"file\":\"" << jsonEscape(event.file) << "\",\"test\":\""
+              << jsonEscape(event.test) << "\"}}";
+        first = false;
+    }
+    for (size_t thread : threads)
+    {
+        trace << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+              << thread << ",\"args\":{\"name\":\"worker " << thread << "\"}}";
+        first = false;
+    }
+    trace << "\n]}\n";
+    return trace.str();
+}
+
+void savePhaseTrace()
+{
+    Options const& opt = Options::get();
+    if (opt.phaselog.empty() && opt.tracelog.empty())
+        return;
+
+    vector<PhaseEvent> const events = collectPhaseEvents();
+    if (!opt.phaselog.empty())
+    {
+        fs::path const file(opt.phaselog);
+        if (file.extension() == ".csv")
+            dev::writeFile(file, phaseEventsCSV(events));
+        else
+            dev::writeFile(file, phaseSummary(events).asJson());
+        ETH_STDOUT_MESSAGE("Test phase timings: " + file.string());
+    }
+    if (!opt.tracelog.empty())
+    {
+        dev::writeFile(opt.tracelog, phaseChromeTrace(events));
+        ETH_STDOUT_MESSAGE("Test phase trace: " + opt.tracelog);
+    }
+}
+
+}  // namespace test
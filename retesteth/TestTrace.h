@@ -0,0 +1,71 @@
+#pragma once
+#include <dataObject/DataObject.h>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace test
+{
+// Phases of test execution recorded with --phaselog / --tracelog
+enum class TestPhase
+{
+    File,            // test file from parse to the output
+    Test,            // test inside a file
+    Parse,           // read json/yml test or filler
+    HashCheck,       // verify filler hash of the compiled test
+    Compile,         // LLL compilation of the code
+    SetChainParams,  // test_setChainParams
+    SendTransaction, // eth_sendRawTransaction
+    Mine,            // test_mineBlocks
+    StateFetch,      // read post state from the client
+    Compare,         // compare post state with expect section
+    OutputWrite      // write filled test
+};
+std::string phaseName(TestPhase _phase);
+
+struct PhaseEvent
+{
+    TestPhase phase;
+    std::string file;
+    std::string test;
+    size_t threadID;
+    int64_t startUs;  // since the program start
+    int64_t durationUs;
+};
+
+// Record the time of the scope as a phase of the current thread test
+// Costs a flag check when the trace is disabled
+class PhaseTimer
+{
+public:
+    PhaseTimer(TestPhase _phase);
+    ~PhaseTimer();
+    // Record the phase before the end of the scope
+    void stop();
+
+private:
+    TestPhase m_phase;
+    bool m_enabled;
+    std::string m_file;
+    std::string m_test;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+// Events are stored in per thread buffers, collected at the end of the run
+bool isPhaseTraceEnabled();
+void enablePhaseTrace(bool _enabled);
+void recordPhase(PhaseEvent const& _event);
+std::vector<PhaseEvent> collectPhaseEvents();
+
+// Total milliseconds of each phase per test file and test
+dataobject::DataObject phaseSummary(std::vector<PhaseEvent> const& _events);
+// One line per event: file,test,phase,thread,start_us,duration_us
+std::string phaseEventsCSV(std::vector<PhaseEvent> const& _events);
+// Chrome trace event format (chrome://tracing, perfetto), a track per worker thread
+std::string phaseChromeTrace(std::vector<PhaseEvent> const& _events);
+
+// Write the files requested by --phaselog and --tracelog
+void savePhaseTrace();
+
+}  // namespace test
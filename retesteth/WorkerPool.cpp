@@ -0,0 +1,194 @@
+#include <retesteth/WorkerPool.h>
+#include <atomic>
+
+using namespace std;
+
+namespace
+{
+thread_local test::WorkerPool* s_currentPool = nullptr;
+}
+
+namespace test
+{
+// Tasks of runTaskGroup. Whoever executes the group (the caller or helper tasks on the workers)
+// takes the next not started task until there are none left
+struct WorkerPool::TaskGroup
+{
+    TaskGroup(std::vector<std::function<void()>> const& _tasks)
+      : tasks(_tasks), nextTask(0), finishedTasks(0)
+    {}
+
+    void execute()
+    {
+        size_t i;
+        while ((i = nextTask++) < tasks.size())
+        {
+            std::exception_ptr taskException;
+            try
+            {
+                tasks.at(i)();
+            }
+            catch (...)
+            {
+                taskException = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (taskException && !groupException)
+                groupException = taskException;
+            if (++finishedTasks == tasks.size())
+                allFinished.notify_all();
+        }
+    }
+
+    std::vector<std::function<void()>> const tasks;
+    std::atomic<size_t> nextTask;
+    std::mutex mutex;
+    std::condition_variable allFinished;
+    size_t finishedTasks;
+    std::exception_ptr groupException;
+};
+
+WorkerPool::WorkerPool(size_t _threadCount, std::function<void()> _onWorkerStart,
+    std::function<void()> _onWorkerExit)
+  : m_onWorkerStart(_onWorkerStart), m_onWorkerExit(_onWorkerExit)
+{
+    for (size_t i = 0; i < max<size_t>(1, _threadCount); i++)
+        m_workers.push_back(thread(&WorkerPool::workerLoop, this));
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        m_tasks.clear();
+    }
+    m_taskAdded.notify_all();
+    for (auto& worker : m_workers)
+        worker.join();
+}
+
+void WorkerPool::addTask(std::function<void()> _task, bool _reportDone)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(Task{std::move(_task), _reportDone});
+    }
+    m_taskAdded.notify_one();
+}
+
+void WorkerPool::runTaskGroup(std::vector<std::function<void()>> const& _tasks)
+{
+    std::shared_ptr<TaskGroup> group = std::make_shared<TaskGroup>(_tasks);
+    if (s_currentPool == this && _tasks.size() > 1)
+    {
+        // Helpers go before queued tasks so the started work is finished first
+        size_t const helpers = min(_tasks.size(), m_workers.size()) - 1;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (size_t i = 0; i < helpers; i++)
+                m_tasks.push_front(Task{[group]() { group->execute(); }, false});
+        }
+        m_taskAdded.notify_all();
+    }
+
+    // The caller executes the group as well, so it never waits for tasks that are not started
+    group->execute();
+    std::unique_lock<std::mutex> lock(group->mutex);
+    group->allFinished.wait(lock, [&group]() { return group->finishedTasks == group->tasks.size(); });
+    if (group->groupException)
+        std::rethrow_exception(group->groupException);
+}
+
+WorkerPool* WorkerPool::current()
+{
+    return s_currentPool;
+}
+
+void WorkerPool::wait(std::function<void()> const& _onTaskDone)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_taskDone.wait(lock, [this]() {
+            return m_doneTasks > 0 || (m_tasks.empty() && m_runningTasks == 0);
+        });
+
+        size_t const doneTasks = m_doneTasks;
+        m_doneTasks = 0;
+        if (_onTaskDone)
+        {
+            // the callback might cancel the pool, don't hold the lock
+            lock.unlock();
+            for (size_t i = 0; i < doneTasks; i++)
+                _onTaskDone();
+            lock.lock();
+        }
+
+        if (m_tasks.empty() && m_runningTasks == 0 && m_doneTasks == 0)
+            break;
+    }
+
+    if (m_taskException)
+    {
+        std::exception_ptr ex = m_taskException;
+        m_taskException = nullptr;
+        std::rethrow_exception(ex);
+    }
+}
+
+void WorkerPool::cancel()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.clear();
+    }
+    m_taskDone.notify_all();
+}
+
+void WorkerPool::workerLoop()
+{
+    s_currentPool = this;
+    if (m_onWorkerStart)
+        m_onWorkerStart();
+    while (true)
+    {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_taskAdded.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+            if (m_stop)
+                break;
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+            m_runningTasks++;
+        }
+
+        std::exception_ptr taskException;
+        try
+        {
+            task.func();
+        }
+        catch (...)
+        {
+            taskException = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_runningTasks--;
+            if (task.reportDone)
+                m_doneTasks++;
+            if (taskException && !m_taskException)
+                m_taskException = taskException;
+        }
+        m_taskDone.notify_all();
+    }
+
+    s_currentPool = nullptr;
+    if (m_onWorkerExit)
+        m_onWorkerExit();
+}
+
+}  // namespace test
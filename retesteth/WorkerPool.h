@@ -0,0 +1,66 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace test
+{
+// Fixed set of threads executing queued tasks
+// Worker threads live until the pool is destroyed, so the session bound to a worker thread id
+// (RPCSession::instance(TestOutputHelper::getThreadID())) serves all of the worker tasks
+class WorkerPool
+{
+public:
+    // _onWorkerStart and _onWorkerExit are called on each worker thread when it starts/finishes
+    WorkerPool(size_t _threadCount, std::function<void()> _onWorkerStart = std::function<void()>(),
+        std::function<void()> _onWorkerExit = std::function<void()>());
+    ~WorkerPool();
+
+    // Tasks added with _reportDone = false are not counted by wait() callback (background work)
+    void addTask(std::function<void()> _task, bool _reportDone = true);
+
+    // Block until all added tasks are finished or cancelled. _onTaskDone is called on the waiting
+    // thread for each finished task. Rethrows the first exception that escaped a task
+    void wait(std::function<void()> const& _onTaskDone = std::function<void()>());
+
+    // Drop the tasks that are not started yet
+    void cancel();
+
+    // Execute _tasks on the calling thread and on idle workers of the pool. Returns when all of
+    // the _tasks are finished. Rethrows the first exception that escaped a task
+    // Must be called from a task of this pool (otherwise tasks are executed on the calling thread)
+    void runTaskGroup(std::vector<std::function<void()>> const& _tasks);
+
+    size_t threadCount() const { return m_workers.size(); }
+
+    // The pool of the calling worker thread. nullptr if called not from a pool task
+    static WorkerPool* current();
+
+private:
+    struct Task
+    {
+        std::function<void()> func;
+        bool reportDone;  // count the task in wait()
+    };
+    struct TaskGroup;
+    void workerLoop();
+
+    std::mutex m_mutex;
+    std::condition_variable m_taskAdded;
+    std::condition_variable m_taskDone;
+    std::deque<Task> m_tasks;
+    size_t m_runningTasks = 0;
+    size_t m_doneTasks = 0;  // finished tasks not yet reported by wait()
+    bool m_stop = false;
+    std::exception_ptr m_taskException;
+    std::function<void()> m_onWorkerStart;
+    std::function<void()> m_onWorkerExit;
+    std::vector<std::thread> m_workers;
+};
+
+}  // namespace test
@@ -9,9 +9,7 @@ using namespace std;
 using namespace test;
 namespace fs = boost::filesystem;
 
-namespace
-{
-fs::path getRetestethDataDir()
+fs::path test::getRetestethDataDir()
 {
     fs::path const& dir = Options::get().datadir;
     bool optionsEmpty = dir.empty();
@@ -21,7 +19,6 @@ fs::path getRetestethDataDir()
             3);
     return optionsEmpty ? getDataDir("retesteth") : dir;
 }
-}  // namespace
 
 string prepareRetestethVersion()
 {
@@ -99,27 +96,38 @@ void deployFirstRunConfigs()
     writeFile(genesisDir / "correctMiningReward.json", default_correctMiningReward_config);
 }
 
+namespace
+{
+// Index in m_clientConfigs of the config set by the thread, -1 if not set
+thread_local int s_threadConfigIndex = -1;
+}  // namespace
+
 ClientConfig const& Options::DynamicOptions::getCurrentConfig() const
 {
-    for (auto const& cfg : m_clientConfigs)
-    {
-        if (cfg.getId() == m_currentConfigID)
-            return cfg;
-    }
-    ETH_FAIL_MESSAGE("ERROR: current config not found! (DynamicOptions::getCurrentConfig())");
-    return m_clientConfigs.at(0);
+    // A thread that uses the config of another thread might test the wrong client
+    ETH_FAIL_REQUIRE_MESSAGE(hasCurrentConfig(),
+        "ERROR: current config is not set for this thread! (DynamicOptions::getCurrentConfig())");
+    return m_clientConfigs.at(s_threadConfigIndex);
+}
+
+bool Options::DynamicOptions::hasCurrentConfig() const
+{
+    return s_threadConfigIndex >= 0 && (size_t)s_threadConfigIndex < m_clientConfigs.size();
 }
 
 void Options::DynamicOptions::setCurrentConfig(ClientConfig const& _config)
 {
     ETH_FAIL_REQUIRE_MESSAGE(getClientConfigs().size() > 0, "No client configs provided!");
-    bool found = false;
-    for (auto const& cfg : getClientConfigs())
+    int configIndex = -1;
+    for (size_t i = 0; i < getClientConfigs().size(); i++)
+    {
+        ClientConfig const& cfg = getClientConfigs().at(i);
         if (cfg.getId() == _config.getId() && cfg.getName() == _config.getName())
-            found = true;
-    ETH_FAIL_REQUIRE_MESSAGE(
-        found, "_config not found in loaded options! (DynamicOptions::setCurrentConfig)");
-    m_currentConfigID = _config.getId();
+            configIndex = i;
+    }
+    ETH_FAIL_REQUIRE_MESSAGE(configIndex >= 0,
+        "_config not found in loaded options! (DynamicOptions::setCurrentConfig)");
+    s_threadConfigIndex = configIndex;
 
     // Verify singleTestNet for the current config
     string const& net = Options::get().singleTestNet;
@@ -115,6 +115,13 @@ std::string const& DataObject::asString() const
     return m_strVal;
 }
 
+/// Get string value to modify it in place
+std::string& DataObject::asStringUnsafe()
+{
+    _assert(m_type == DataType::String, "m_type == DataType::String (DataObject::asStringUnsafe())");
+    return m_strVal;
+}
+
 /// Get int value
 int DataObject::asInt() const
 {
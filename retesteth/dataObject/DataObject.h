@@ -40,6 +40,7 @@ public:
 
     bool count(std::string const& _key) const;
     std::string const& asString() const;
+    std::string& asStringUnsafe();
     int asInt() const;
     bool asBool() const;
 
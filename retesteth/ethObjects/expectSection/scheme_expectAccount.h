@@ -41,79 +41,6 @@ public:
         m_data["balance"] = dev::toCompactHexPrefixed(_balance, 1);
     }
     std::string const& address() const { return getData().getKey(); }
-    CompareResult compareStorage(DataObject const& _storage) const
-    {
-        CompareResult result = CompareResult::Success;
-        auto checkMessage = [&result](bool _flag, CompareResult _type,
-                                std::string const& _error) -> void {
-            ETH_MARK_ERROR_FLAG(_flag, _error);
-            if (!_flag)
-                result = _type;
-        };
-
-        ETH_ERROR_REQUIRE_MESSAGE(
-            _storage.type() == DataType::Object, "Storage must be of `Object` type!");
-        ETH_ERROR_REQUIRE_MESSAGE(hasStorage(), "Storage was expected to be set!");
-
-        DataObject const& expectStorage = m_data.atKey("storage");
-        for (auto const& element : expectStorage.getSubObjects())
-        {
-            // Check that storage element is set
-            string key = element.getKey();
-            if (key == "0x" && _storage.count("0x00"))
-                key = "0x00";
-            else if (key == "0x00" && _storage.count("0x"))
-                key = "0x";
-
-            string const message = "Check State: Remote account '" + address() + "'";
-            if (element.asString() == "0x" || element.asString() == "0x00")
-            {
-                // check that empty element is not set
-                // if a post state has the value of 'key' as zero, such 'key' does not listed
-                string const& val = _storage.count(key) ? _storage.atKey(key).asString() : "";
-                checkMessage(!_storage.count(key), CompareResult::IncorrectStorage,
-                    message + " has storage key '" + element.getKey() +
-                        "' : '" + val + "'. Test expected storage key: '" + element.getKey() +
-                        "' to be set to zero");
-            }
-            else
-            {
-                // check that expected element exist
-                checkMessage(_storage.count(key), CompareResult::IncorrectStorage,
-                    message + " test expected storage key: '" + element.getKey() +
-                        "' to be set to: '" + element.asString() + "', but remote key '" +
-                        element.getKey() + "' does not exist!");
-
-                if (result != CompareResult::Success)
-                    return result;
-
-                // if expected element exist, check exact value in the storage
-                std::string valueInStorage = _storage.atKey(key).asString();
-                checkMessage(valueInStorage == element.asString(), CompareResult::IncorrectStorage,
-                    message + ": has incorrect storage [" + key + "] = " + valueInStorage +
-                        ", test expected [" + key + "] = " + element.asString());
-            }
-        }
-        checkMessage(expectStorage.getSubObjects().size() >= _storage.getSubObjects().size(),
-            CompareResult::IncorrectStorage,
-            TestOutputHelper::get().testName() + " Remote account '" + address() +
-                "' storage has more storage records than expected!");
-
-        if (expectStorage.getSubObjects().size() < _storage.getSubObjects().size())
-        {
-            for (auto const& element : _storage.getSubObjects())
-            {
-                string expected = "0";
-                if (expectStorage.count(element.getKey()))
-                    expected = expectStorage.atKey(element.getKey()).asString();
-                string const message = "incorrect remote storage [" + element.getKey() +
-                                       "] = " + element.asString() + ", test expected [" +
-                                       element.getKey() + "] = " + expected;
-                ETH_MARK_ERROR(message);
-            }
-        }
-        return result;
-    }
 
 private:
     bool m_shouldNotExist;
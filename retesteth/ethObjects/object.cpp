@@ -10,12 +10,7 @@ string object::emptyString;
 void mod_valuesToLowerCase(DataObject& _obj)
 {
     if (_obj.type() == DataType::String)
-    {
-        string value = _obj.asString();
-        std::transform(value.begin(), value.end(), value.begin(),
-            [](unsigned char c) { return std::tolower(c); });
-        _obj = value;
-    }
+        dev::toLowerCase(_obj.asStringUnsafe());
 }
 
 // Remove leading zeros from hex values leaving 0x0004 - > 0x4
@@ -23,19 +18,7 @@ void mod_removeLeadingZerosFromHexValues(DataObject& _obj)
 {
     static std::vector<std::string> const c_hashes{std::string{"to"}, std::string{"data"}};
     if (_obj.type() == DataType::String && !inArray(c_hashes, _obj.getKey()))
-    {
-        string const& origVal = _obj.asString();
-        bool replacePossible = true;
-        while (replacePossible)
-        {
-            if (origVal[0] == '0' && origVal[1] == 'x' && origVal[2] == '0' && origVal.size() >= 4)
-            {
-                _obj.setString("0x" + origVal.substr(3));
-                continue;
-            }
-            replacePossible = false;
-        }
-    }
+        dev::removeLeadingHexZeros(_obj.asStringUnsafe());
 }
 
 // Remove leading zeros from hex values leaving 0x0004 - > 0x04
@@ -1,6 +1,12 @@
 #include "scheme_block.h"
 #include "TestHelper.h"
 
+namespace
+{
+// Header with the bloom is about 540 bytes
+size_t const c_blockRLPReserve = 2048;
+}
+
 DataObject const& getEmptySchemeBlockData()
 {
     static DataObject emptySchemeBlockData(DataType::Null);
@@ -94,42 +100,44 @@ std::string scheme_RPCBlock::getBlockRLP() const
         "Attempt to get blockRLP of a block received without full transactions!");
     // RLP of a block
     // rlpHead .. blockinfo transactions uncles
-    RLPStream stream(3);
-    DataObject const& headerData = m_blockHeader.getData();
-    stream.appendRaw(streamBlockHeader(headerData).out());
+    // The block is encoded into one stream which reuses the buffer of the previous block
+    thread_local bytes t_buffer;
+    RLPStream stream(std::move(t_buffer));
+    stream.reserve(c_blockRLPReserve);
+    stream.appendList(3);
+    streamBlockHeader(m_blockHeader.getData(), stream);
 
-    size_t trCount = m_data.atKey("transactions").getSubObjects().size();
-    RLPStream transactionList(trCount);
-    for (size_t i = 0; i < trCount; i++)
+    auto const& transactions = m_data.atKey("transactions").getSubObjects();
+    stream.appendList(transactions.size());
+    for (auto const& transaction : transactions)
     {
-        RLPStream transactionRLP(9);
-        DataObject transaction = m_data.atKey("transactions").getSubObjects().at(i);
-        transactionRLP << u256(transaction.atKey("nonce").asString());
-        transactionRLP << u256(transaction.atKey("gasPrice").asString());
-        transactionRLP << u256(transaction.atKey("gas").asString());
+        stream.appendList(9);
+        stream << u256(transaction.atKey("nonce").asString());
+        stream << u256(transaction.atKey("gasPrice").asString());
+        stream << u256(transaction.atKey("gas").asString());
         if (transaction.atKey("to").type() == DataType::Null ||
             transaction.atKey("to").asString().empty())
-            transactionRLP << "";
+            stream << "";
         else
-            transactionRLP << Address(transaction.atKey("to").asString());
-        transactionRLP << u256(transaction.atKey("value").asString());
-        transactionRLP << test::sfromHex(transaction.atKey("input").asString());
+            stream << Address(transaction.atKey("to").asString());
+        stream << u256(transaction.atKey("value").asString());
+        stream << test::sfromHex(transaction.atKey("input").asString());
 
         byte v = (int)u256(transaction.atKey("v").asString().c_str());
         if (v <= 1)
         {
             v += 27;  // To deal with Aleth's logic to subtract 27 from V when it is 27 or 28
         }
-        transactionRLP << v;
-        transactionRLP << u256(transaction.atKey("r").asString());
-        transactionRLP << u256(transaction.atKey("s").asString());
-        transactionList.appendRaw(transactionRLP.out());
+        stream << v;
+        stream << u256(transaction.atKey("r").asString());
+        stream << u256(transaction.atKey("s").asString());
     }
-    stream.appendRaw(transactionList.out());  // transaction list
 
     stream.appendRaw(streamUncles().out());  // uncle list
 
-    return dev::toHexPrefixed(stream.out());
+    string const rlp = dev::toHexPrefixed(stream.out());
+    stream.swapOut(t_buffer);
+    return rlp;
 }
 
 RLPStream scheme_RPCBlock::streamUncles() const
@@ -144,32 +152,37 @@ RLPStream scheme_RPCBlock::streamUncles() const
 RLPStream scheme_RPCBlock::streamBlockHeader(DataObject const& _headerData)
 {
     RLPStream header;
-    header.appendList(15);
+    streamBlockHeader(_headerData, header);
+    return header;
+}
+
+void scheme_RPCBlock::streamBlockHeader(DataObject const& _headerData, RLPStream& _out)
+{
+    _out.appendList(15);
 
-    header << h256(_headerData.atKey("parentHash").asString());
-    header << h256(_headerData.atKey("uncleHash").asString());
-    header << dev::Address(_headerData.atKey("coinbase").asString());
-    header << h256(_headerData.atKey("stateRoot").asString());
-    header << h256(_headerData.atKey("transactionsTrie").asString());
-    header << h256(_headerData.atKey("receiptTrie").asString());
-    header << h2048(_headerData.atKey("bloom").asString());
-    header << u256(_headerData.atKey("difficulty").asString());
-    header << u256(_headerData.atKey("number").asString());
-    header << u256(_headerData.atKey("gasLimit").asString());
-    header << u256(_headerData.atKey("gasUsed").asString());
-    header << u256(_headerData.atKey("timestamp").asString());
-    header << test::sfromHex(_headerData.atKey("extraData").asString());
+    _out << h256(_headerData.atKey("parentHash").asString());
+    _out << h256(_headerData.atKey("uncleHash").asString());
+    _out << dev::Address(_headerData.atKey("coinbase").asString());
+    _out << h256(_headerData.atKey("stateRoot").asString());
+    _out << h256(_headerData.atKey("transactionsTrie").asString());
+    _out << h256(_headerData.atKey("receiptTrie").asString());
+    _out << h2048(_headerData.atKey("bloom").asString());
+    _out << u256(_headerData.atKey("difficulty").asString());
+    _out << u256(_headerData.atKey("number").asString());
+    _out << u256(_headerData.atKey("gasLimit").asString());
+    _out << u256(_headerData.atKey("gasUsed").asString());
+    _out << u256(_headerData.atKey("timestamp").asString());
+    _out << test::sfromHex(_headerData.atKey("extraData").asString());
     if (_headerData.count("mixHash"))
     {
-        header << h256(_headerData.atKey("mixHash").asString());
-        header << h64(_headerData.atKey("nonce").asString());
+        _out << h256(_headerData.atKey("mixHash").asString());
+        _out << h64(_headerData.atKey("nonce").asString());
     }
     else
     {
-        header << h256(0);
-        header << h64(0);
+        _out << h256(0);
+        _out << h64(0);
     }
-    return header;
 }
 
 void scheme_RPCBlock::recalculateUncleHash()
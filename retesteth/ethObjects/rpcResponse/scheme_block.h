@@ -86,6 +86,7 @@ public:
     scheme_RPCBlock(std::string const& _RLP);
     scheme_RPCBlock(DataObject const& _block);
     static RLPStream streamBlockHeader(DataObject const& _headerData);
+    static void streamBlockHeader(DataObject const& _headerData, RLPStream& _out);
 
     void addUncle(scheme_RPCBlock const& _block) { m_uncles.push_back(_block); }
 
@@ -0,0 +1,86 @@
+#include "NativeState.h"
+#include <libdevcore/Exceptions.h>
+#include <libdevcore/SHA3.h>
+using namespace test;
+using namespace std;
+
+namespace test
+{
+u256 nativeValue(string const& _hex)
+{
+    if (_hex.empty() || _hex == "0x")
+        return 0;
+    return u256(_hex);
+}
+
+h256 nativeStorageKey(string const& _hex)
+{
+    return h256(nativeValue(_hex));
+}
+
+NativeState::NativeState(scheme_state const& _state)
+{
+    m_accounts.reserve(_state.getAccounts().size());
+    for (auto const& account : _state.getAccounts())
+        m_accounts[Address(account.getData().getKey())] = makeAccount(account);
+}
+
+NativeAccount NativeState::makeAccount(scheme_account const& _account)
+{
+    DataObject const& data = _account.getData();
+    NativeAccount account;
+    account.balance = nativeValue(data.atKey("balance").asString());
+    account.nonce = nativeValue(data.atKey("nonce").asString());
+    account.code = fromHex(data.atKey("code").asString());
+    account.codeHash = sha3(account.code);
+    auto const& storage = data.atKey("storage").getSubObjects();
+    account.storage.reserve(storage.size());
+    for (auto const& record : storage)
+        account.storage[nativeStorageKey(record.getKey())] = nativeValue(record.asString());
+    return account;
+}
+
+NativeAccount const* NativeState::getAccount(Address const& _address) const
+{
+    auto const account = m_accounts.find(_address);
+    return account == m_accounts.end() ? nullptr : &account->second;
+}
+
+NativeExpectAccount::NativeExpectAccount(scheme_expectAccount const& _account)
+  : address(_account.address()),
+    addressString(_account.address()),
+    shouldNotExist(_account.shouldNotExist()),
+    hasBalance(_account.hasBalance()),
+    hasNonce(_account.hasNonce()),
+    hasCode(_account.hasCode()),
+    hasStorage(_account.hasStorage())
+{
+    DataObject const& data = _account.getData();
+    if (hasBalance)
+        balance = nativeValue(data.atKey("balance").asString());
+    if (hasNonce)
+        nonce = nativeValue(data.atKey("nonce").asString());
+    if (hasCode)
+    {
+        string const& codeHex = data.atKey("code").asString();
+        try
+        {
+            code = fromHex(codeHex, WhenError::Throw);
+        }
+        catch (BadHexCharacter const&)
+        {
+            ETH_ERROR_MESSAGE("Expect section account '" + addressString +
+                              "' code is expected to be hex: '" + codeHex + "'");
+        }
+    }
+    if (hasStorage)
+    {
+        ETH_ERROR_REQUIRE_MESSAGE(data.atKey("storage").type() == DataType::Object,
+            "Storage must be of `Object` type!");
+        for (auto const& record : data.atKey("storage").getSubObjects())
+            storage.push_back(
+                {nativeStorageKey(record.getKey()), nativeValue(record.asString())});
+    }
+}
+
+}  // namespace test
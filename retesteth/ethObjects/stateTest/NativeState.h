@@ -0,0 +1,63 @@
+#pragma once
+#include "../expectSection/scheme_expectState.h"
+#include "scheme_state.h"
+#include <libdevcore/Address.h>
+#include <unordered_map>
+
+namespace test
+{
+// Values of the json state are parsed once into these maps, so comparing the states
+// does not look up and compare hex strings
+typedef std::unordered_map<dev::h256, dev::u256> NativeStorage;
+
+struct NativeAccount
+{
+    dev::u256 balance;
+    dev::u256 nonce;
+    dev::bytes code;
+    dev::h256 codeHash;
+    // records as listed in the state. A remote state must not list zero values,
+    // so they are kept and reported by the compare
+    NativeStorage storage;
+};
+
+class NativeState
+{
+public:
+    NativeState() {}
+    // pre, post, remote or t8n state
+    NativeState(scheme_state const& _state);
+
+    static NativeAccount makeAccount(scheme_account const& _account);
+    NativeAccount const* getAccount(dev::Address const& _address) const;
+    std::unordered_map<dev::Address, NativeAccount> const& getAccounts() const { return m_accounts; }
+
+private:
+    std::unordered_map<dev::Address, NativeAccount> m_accounts;
+};
+
+// Account of the expect section, only the declared fields are compared
+struct NativeExpectAccount
+{
+    NativeExpectAccount(scheme_expectAccount const& _account);
+
+    dev::Address address;
+    std::string addressString;
+    bool shouldNotExist;
+    bool hasBalance;
+    bool hasNonce;
+    bool hasCode;
+    bool hasStorage;
+    dev::u256 balance;
+    dev::u256 nonce;
+    dev::bytes code;
+    // in the order of expect section, zero value means the key must not be set
+    std::vector<std::pair<dev::h256, dev::u256>> storage;
+};
+
+// Hex value of the state, "0x" is zero
+dev::u256 nativeValue(std::string const& _hex);
+// Storage key of the state, "0x" is zero
+dev::h256 nativeStorageKey(std::string const& _hex);
+
+}  // namespace test
@@ -0,0 +1,26 @@
+#include "scheme_account.h"
+#include <libdevcore/RLP.h>
+#include <libdevcore/SHA3.h>
+#include <libdevcore/TrieHash.h>
+using namespace test;
+using namespace std;
+
+h256 scheme_account::storageRoot() const
+{
+    BytesMap storage;
+    for (auto const& record : m_data.atKey("storage").getSubObjects())
+    {
+        u256 const value(record.asString());
+        if (value != 0)
+            storage[h256(u256(record.getKey())).asBytes()] = dev::rlp(value);
+    }
+    return secureTrieRoot(storage);
+}
+
+bytes scheme_account::rlp() const
+{
+    RLPStream account(4);
+    account << u256(m_data.atKey("nonce").asString()) << u256(m_data.atKey("balance").asString())
+            << storageRoot() << sha3(fromHex(m_data.atKey("code").asString()));
+    return account.out();
+}
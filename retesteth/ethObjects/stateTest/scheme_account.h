@@ -1,5 +1,6 @@
 #pragma once
 #include "../object.h"
+#include <libdevcore/FixedHash.h>
 #include <retesteth/TestHelper.h>
 
 using namespace dev;
@@ -41,6 +42,11 @@ public:
         makeAllFieldsHex(m_data);
     }
 
+    // Root of the account storage trie, zero values are not stored
+    dev::h256 storageRoot() const;
+    // RLP of the account in the state trie: [nonce, balance, storageRoot, codeHash]
+    dev::bytes rlp() const;
+
     static void validateStorage(DataObject const& _accountObject)
     {
         // verify that storage in test is string and is digit or hex representation
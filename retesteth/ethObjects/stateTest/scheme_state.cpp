@@ -0,0 +1,13 @@
+#include "scheme_state.h"
+#include <libdevcore/Address.h>
+#include <libdevcore/TrieHash.h>
+using namespace test;
+using namespace std;
+
+h256 scheme_state::stateRoot() const
+{
+    BytesMap accounts;
+    for (auto const& account : m_accounts)
+        accounts[Address(account.getData().getKey()).asBytes()] = account.rlp();
+    return secureTrieRoot(accounts);
+}
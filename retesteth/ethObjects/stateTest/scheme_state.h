@@ -19,6 +19,8 @@ public:
     }
 
     bool isHash() const { return !m_hash.empty(); }
+    // State root computed from the accounts, without a client
+    dev::h256 stateRoot() const;
     string const& getHash() const { return m_hash; }
     std::vector<scheme_account> const& getAccounts() const { return m_accounts; }
     bool hasAccount(std::string const& _address) const
@@ -0,0 +1,222 @@
+#include "scheme_transaction.h"
+#include <retesteth/WorkerPool.h>
+#include <atomic>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace test;
+using namespace std;
+
+namespace
+{
+std::atomic<size_t> g_signaturesPerformed(0);
+std::atomic<size_t> g_signedTransactionHits(0);
+
+// Signed transactions by the transaction fields, shared by all tests and sessions
+// Least recently used are dropped, hits are within a test and its copies of the transactions
+size_t const c_signedTransactionsMaxEntries = 4096;
+typedef std::shared_ptr<scheme_transaction::SignedTransaction const> SignedTransactionPtr;
+struct SignedTransactionEntry
+{
+    SignedTransactionPtr signedTr;
+    list<string>::iterator lruPos;
+};
+mutex g_signedTransactionsMutex;
+unordered_map<string, SignedTransactionEntry> g_signedTransactions;
+list<string> g_signedTransactionsLRU;
+
+// Both require g_signedTransactionsMutex
+SignedTransactionPtr findSignedTransaction(string const& _key)
+{
+    auto const it = g_signedTransactions.find(_key);
+    if (it == g_signedTransactions.end())
+        return SignedTransactionPtr();
+    g_signedTransactionsLRU.splice(
+        g_signedTransactionsLRU.begin(), g_signedTransactionsLRU, it->second.lruPos);
+    return it->second.signedTr;
+}
+
+// Returns the transaction signed before by another thread if there is one
+SignedTransactionPtr rememberSignedTransaction(string const& _key, SignedTransactionPtr const& _tr)
+{
+    if (SignedTransactionPtr const existing = findSignedTransaction(_key))
+        return existing;
+    g_signedTransactionsLRU.push_front(_key);
+    g_signedTransactions[_key] = {_tr, g_signedTransactionsLRU.begin()};
+    if (g_signedTransactionsLRU.size() > c_signedTransactionsMaxEntries)
+    {
+        g_signedTransactions.erase(g_signedTransactionsLRU.back());
+        g_signedTransactionsLRU.pop_back();
+    }
+    return _tr;
+}
+
+// RLP of the 9 transaction fields other than data with their prefixes and the list prefix
+size_t const c_transactionFieldsRLPSize = 9 * 33 + 9;
+
+string transactionFieldsKey(DataObject const& _data)
+{
+    string key;
+    for (auto const& field :
+        {"nonce", "gasPrice", "gasLimit", "to", "value", "data", "secretKey", "v", "r", "s"})
+    {
+        key += _data.count(field) ? _data.atKey(field).asString() : string();
+        key += ":";
+    }
+    return key;
+}
+
+// Appends the fields which are signed: nonce, gasPrice, gasLimit, to, value, data
+void streamUnsignedFields(DataObject const& _data, dev::bytes const& _trData, dev::RLPStream& _s)
+{
+    _s << u256(_data.atKey("nonce").asString());
+    _s << u256(_data.atKey("gasPrice").asString());
+    _s << u256(_data.atKey("gasLimit").asString());
+    if (_data.atKey("to").asString().size() == 42)
+        _s << Address(_data.atKey("to").asString());
+    else
+        _s << "";
+    _s << u256(_data.atKey("value").asString());
+    _s << _trData;
+}
+}  // namespace
+
+namespace test
+{
+DataObject scheme_transaction::getDataForBCTest() const
+{
+    DataObject newData = m_data;
+    newData.removeKey("gas");
+    if (newData.count("secretKey"))
+    {
+        SignatureStruct const& sig = getSigned().signature;
+        newData.removeKey("secretKey");
+        newData["v"] = toCompactHexPrefixed(27 + int(sig.v));
+        newData["r"] = toCompactHexPrefixed(sig.r, 1);
+        newData["s"] = toCompactHexPrefixed(sig.s, 1);
+    }
+    return newData;
+}
+
+std::string scheme_transaction::getSignedRLP(SignatureStruct* _returnSig) const
+{
+    SignedTransaction const& signedTr = getSigned();
+    if (_returnSig != 0)
+    {
+        _returnSig->v = signedTr.signature.v;
+        _returnSig->r = signedTr.signature.r;
+        _returnSig->s = signedTr.signature.s;
+    }
+    return signedTr.signedRLP;
+}
+
+size_t scheme_transaction::signaturesPerformed()
+{
+    return g_signaturesPerformed;
+}
+
+size_t scheme_transaction::signedTransactionHits()
+{
+    return g_signedTransactionHits;
+}
+
+void scheme_transaction::signAll(std::vector<scheme_transaction const*> const& _transactions)
+{
+    // One task for each distinct transaction which is not signed yet
+    std::vector<std::function<void()>> tasks;
+    {
+        std::unordered_set<string> keys;
+        lock_guard<mutex> lock(g_signedTransactionsMutex);
+        for (scheme_transaction const* tr : _transactions)
+        {
+            if (std::atomic_load(&tr->m_signed))
+                continue;
+            string const key = transactionFieldsKey(tr->m_data);
+            if (!g_signedTransactions.count(key) && keys.insert(key).second)
+                tasks.push_back([tr]() { tr->getSigned(); });
+        }
+    }
+
+    if (WorkerPool* pool = WorkerPool::current())
+        pool->runTaskGroup(tasks);
+    else
+        for (auto const& task : tasks)
+            task();
+}
+
+scheme_transaction::SignedTransaction const& scheme_transaction::getSigned() const
+{
+    // m_signed is shared between copies of the transaction which might be used by other threads
+    std::shared_ptr<SignedTransaction const> signedTr = std::atomic_load(&m_signed);
+    if (signedTr)
+        return *signedTr;
+
+    string const key = transactionFieldsKey(m_data);
+    {
+        lock_guard<mutex> lock(g_signedTransactionsMutex);
+        signedTr = findSignedTransaction(key);
+        if (signedTr)
+            g_signedTransactionHits++;
+    }
+    if (!signedTr)
+    {
+        signedTr = signTransaction(m_data);
+        lock_guard<mutex> lock(g_signedTransactionsMutex);
+        signedTr = rememberSignedTransaction(key, signedTr);
+    }
+    std::atomic_store(&m_signed, signedTr);
+    return *signedTr;
+}
+
+std::shared_ptr<scheme_transaction::SignedTransaction const> scheme_transaction::signTransaction(
+    DataObject const& _data)
+{
+    bytes data = sfromHex(_data.atKey("data").asString());
+    dev::RLPStream s;
+    s.reserve(data.size() + c_transactionFieldsRLPSize);
+    s.appendList(6);
+    streamUnsignedFields(_data, data, s);
+    h256 hash(dev::sha3(s.out()));
+
+    SignatureStruct sigStruct;
+    if (_data.count("secretKey"))
+    {
+        if (_data.atKey("secretKey").asString().compare("0xaa") == 0) {
+            sigStruct = SignatureStruct(u256(0), u256(0), 0);
+        }
+        else
+        {
+            Signature sig = dev::sign(dev::Secret(_data.atKey("secretKey").asString()), hash);
+            g_signaturesPerformed++;
+            sigStruct = *(SignatureStruct const*)&sig;
+            ETH_FAIL_REQUIRE_MESSAGE(sigStruct.isValid(),
+                TestOutputHelper::get().testName() + " Could not construct transaction signature!");
+        }
+    }
+    else
+    {
+        u256 vValue(_data.atKey("v").asString());
+        sigStruct = SignatureStruct(u256(_data.atKey("r").asString()),
+            u256(_data.atKey("s").asString()), vValue.convert_to<byte>());
+    }
+
+    RLPStream sWithSignature;
+    sWithSignature.reserve(data.size() + c_transactionFieldsRLPSize);
+    sWithSignature.appendList(9);
+    streamUnsignedFields(_data, data, sWithSignature);
+    byte v = _data.count("secretKey") ? 27 + sigStruct.v : sigStruct.v;
+    sWithSignature << v;
+    sWithSignature << (u256)sigStruct.r;
+    sWithSignature << (u256)sigStruct.s;
+
+    std::shared_ptr<SignedTransaction> signedTr(new SignedTransaction());
+    signedTr->signature = sigStruct;
+    signedTr->signedRLP = dev::toHexPrefixed(sWithSignature.out());
+    signedTr->hash = dev::toHexPrefixed(dev::sha3(sWithSignature.out()));
+    return signedTr;
+}
+
+}  // namespace test
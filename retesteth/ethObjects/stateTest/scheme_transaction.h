@@ -6,6 +6,7 @@
 #include <libdevcore/RLP.h>
 #include <libdevcore/SHA3.h>
 #include <libdevcrypto/Common.h>
+#include <memory>
 using namespace dev;
 
 namespace test {
@@ -65,95 +66,31 @@ public:
 
     bool isMarkedInvalid() const { return m_data.count("invalid"); }
 
-    DataObject getDataForBCTest() const
-    {
-        DataObject newData = m_data;
-        newData.removeKey("gas");
-        if (newData.count("secretKey"))
-        {
-            SignatureStruct sig;
-            getSignedRLP(&sig);
-            newData.removeKey("secretKey");
-            newData["v"] = toCompactHexPrefixed(27 + int(sig.v));
-            newData["r"] = toCompactHexPrefixed(sig.r, 1);
-            newData["s"] = toCompactHexPrefixed(sig.s, 1);
-        }
-        return newData;
-    }
-
-    std::string getHash() const
-    {
-        return dev::toHexPrefixed(dev::sha3(dev::fromHex(getSignedRLP())));
-    }
-
-    std::string getSignedRLP(SignatureStruct* _returnSig = 0) const
-    {
-        u256 nonce = u256(m_data.atKey("nonce").asString());
-        u256 gasPrice = u256(m_data.atKey("gasPrice").asString());
-        u256 gasLimit = u256(m_data.atKey("gasLimit").asString());
-        Address trTo = Address(m_data.atKey("to").asString());
-        u256 value = u256(m_data.atKey("value").asString());
-        bytes data = sfromHex(m_data.atKey("data").asString());
-
-        dev::RLPStream s;
-        s.appendList(6);
-        s << nonce;
-        s << gasPrice;
-        s << gasLimit;
-        if (m_data.atKey("to").asString().size() == 42)
-            s << trTo;
-        else
-            s << "";
-        s << value;
-        s << data;
-        h256 hash(dev::sha3(s.out()));
+    DataObject getDataForBCTest() const;
+    std::string const& getHash() const { return getSigned().hash; }
+    std::string getSignedRLP(SignatureStruct* _returnSig = 0) const;
 
-        SignatureStruct sigStruct;
-        if (m_data.count("secretKey"))
-        {
-            if (m_data.atKey("secretKey").asString().compare("0xaa") == 0) {
-                sigStruct = SignatureStruct(u256(0), u256(0), 0);
-            }
-            else
-            {
-                Signature sig = dev::sign(dev::Secret(m_data.atKey("secretKey").asString()), hash);
-                sigStruct = *(SignatureStruct const*)&sig;
-                ETH_FAIL_REQUIRE_MESSAGE(sigStruct.isValid(),
-                                         TestOutputHelper::get().testName() + " Could not construct transaction signature!");
-            }
+    /// Number of secp256k1 signatures calculated for the transactions during this run
+    static size_t signaturesPerformed();
+    /// Number of transactions which took the signature of an equal transaction signed before
+    static size_t signedTransactionHits();
 
-        }
-        else
-        {
-            u256 vValue(m_data.atKey("v").asString());
-            sigStruct = SignatureStruct(u256(m_data.atKey("r").asString()),
-                u256(m_data.atKey("s").asString()), vValue.convert_to<byte>());
-        }
+    /// Sign the distinct _transactions which are not signed yet at once, on the idle workers
+    /// if called from a pool. Results are shared with equal transactions as by getHash()
+    static void signAll(std::vector<scheme_transaction const*> const& _transactions);
 
-        if (_returnSig != 0)
-        {
-            _returnSig->v = sigStruct.v;
-            _returnSig->r = sigStruct.r;
-            _returnSig->s = sigStruct.s;
-        }
+    /// Signature, signed rlp and hash are calculated once per distinct transaction
+    struct SignedTransaction
+    {
+        SignatureStruct signature;
+        std::string signedRLP;
+        std::string hash;
+    };
 
-        RLPStream sWithSignature;
-        sWithSignature.appendList(9);
-        sWithSignature << nonce;
-        sWithSignature << gasPrice;
-        sWithSignature << gasLimit;
-        if (m_data.atKey("to").asString().size() == 42)
-            sWithSignature << trTo;
-        else
-            sWithSignature << "";
-        sWithSignature << value;
-        sWithSignature << data;
-        byte v = m_data.count("secretKey") ? 27 + sigStruct.v : sigStruct.v;
-        sWithSignature << v;
-        sWithSignature << (u256)sigStruct.r;
-        sWithSignature << (u256)sigStruct.s;
-        return dev::toHexPrefixed(sWithSignature.out());
-    }
+private:
+    SignedTransaction const& getSigned() const;
+    static std::shared_ptr<SignedTransaction const> signTransaction(DataObject const& _data);
+    mutable std::shared_ptr<SignedTransaction const> m_signed;
 };
 
     class scheme_generalTransaction: public object
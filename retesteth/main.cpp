@@ -5,6 +5,7 @@
 #include <retesteth/Options.h>
 #include <retesteth/TestHelper.h>
 #include <retesteth/TestOutputHelper.h>
+#include <retesteth/TestShards.h>
 #include <retesteth/session/RPCSession.h>
 #include <retesteth/testSuites/StateTests.h>
 #include <retesteth/testSuites/blockchain/BlockchainTests.h>
@@ -125,6 +126,9 @@ int main(int argc, const char* argv[])
 	}
 
 	test::Options const& opt = test::Options::get();
+	if (!opt.mergeShardFiles.empty())
+		return test::printMergedShardResults(opt.mergeShardFiles);
+
 	if (opt.createRandomTest || opt.singleTestFile.is_initialized())
 	{
 		bool testSuiteFound = false;
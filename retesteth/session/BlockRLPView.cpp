@@ -0,0 +1,135 @@
+#include <libdevcore/SHA3.h>
+#include <retesteth/session/BlockRLPView.h>
+
+using namespace std;
+using namespace dev;
+using namespace dataobject;
+
+namespace
+{
+// Hex of the rlp field as clients return it, empty value is "0x0"
+string fieldHex(bytesConstRef _field, string const& _empty = "0x0")
+{
+    return _field.empty() ? _empty : toHexPrefixed(_field);
+}
+
+// Reads the data fields of the _rlp list in one pass
+template <size_t N>
+void readFields(RLP const& _rlp, bytesConstRef (&o_fields)[N], string const& _what)
+{
+    if (!_rlp.isList())
+        throw RLPException("RLP " + _what + " is expected to be list");
+    size_t i = 0;
+    for (auto const& field : _rlp)
+    {
+        if (i == N)
+            throw RLPException(_what + " rlp has more than " + to_string(N) + " fields!");
+        if (!field.isData())
+            throw RLPException(_what + " rlp field is not data!");
+        o_fields[i++] = field.payload();
+    }
+    if (i != N)
+        throw RLPException(_what + " rlp is expected to have " + to_string(N) + " fields!");
+}
+}  // namespace
+
+namespace toolimpl
+{
+BlockHeaderView::BlockHeaderView(RLP const& _rlp) : m_raw(_rlp.data())
+{
+    readFields(_rlp, m_fields, "blockHeader");
+
+    // Fields must be encoded the way the header is hashed
+    for (Field field : {ParentHash, UncleHash, StateRoot, TransactionsTrie, ReceiptTrie, MixHash})
+        if (m_fields[field].size() != h256::size)
+            throw RLPException("Blockheader hash field has wrong size!");
+    if (m_fields[Coinbase].size() != Address::size)
+        throw RLPException("Blockheader coinbase has wrong size!");
+    if (m_fields[Bloom].size() != h2048::size)
+        throw RLPException("Blockheader bloom has wrong size!");
+    if (m_fields[Nonce].size() != h64::size)
+        throw RLPException("Blockheader nonce has wrong size!");
+    for (Field field : {Difficulty, Number, GasLimit, GasUsed, Timestamp})
+    {
+        bytesConstRef const value = m_fields[field];
+        if (value.size() > 32 || (!value.empty() && value[0] == 0))
+            throw RLPException("Blockheader integer field is not canonical!");
+    }
+}
+
+h256 BlockHeaderView::hash() const
+{
+    return sha3(m_raw);
+}
+
+DataObject BlockHeaderView::toData() const
+{
+    DataObject bData;
+    bData["parentHash"] = fieldHex(m_fields[ParentHash]);
+    bData["uncleHash"] = fieldHex(m_fields[UncleHash]);
+    bData["coinbase"] = fieldHex(m_fields[Coinbase]);
+    bData["stateRoot"] = fieldHex(m_fields[StateRoot]);
+    bData["transactionsTrie"] = fieldHex(m_fields[TransactionsTrie]);
+    bData["receiptTrie"] = fieldHex(m_fields[ReceiptTrie]);
+    bData["bloom"] = fieldHex(m_fields[Bloom]);
+    bData["difficulty"] = fieldHex(m_fields[Difficulty]);
+    bData["number"] = fieldHex(m_fields[Number]);
+    bData["gasLimit"] = fieldHex(m_fields[GasLimit]);
+    bData["gasUsed"] = fieldHex(m_fields[GasUsed]);
+    bData["timestamp"] = fieldHex(m_fields[Timestamp]);
+    bData["extraData"] = fieldHex(m_fields[ExtraData]);
+    bData["mixHash"] = fieldHex(m_fields[MixHash]);
+    bData["nonce"] = fieldHex(m_fields[Nonce]);
+    bData["hash"] = toHexPrefixed(hash());
+    return bData;
+}
+
+TransactionView::TransactionView(RLP const& _rlp) : m_raw(_rlp.data())
+{
+    readFields(_rlp, m_fields, "Transaction");
+}
+
+h256 TransactionView::hash() const
+{
+    return sha3(m_raw);
+}
+
+DataObject TransactionView::toData() const
+{
+    DataObject bData;
+    bData["nonce"] = fieldHex(m_fields[Nonce]);
+    bData["gasPrice"] = fieldHex(m_fields[GasPrice]);
+    bData["gasLimit"] = fieldHex(m_fields[GasLimit]);
+    bData["to"] = fieldHex(m_fields[To], "");
+    bData["value"] = fieldHex(m_fields[Value]);
+    bData["data"] = fieldHex(m_fields[Data], "");
+    bData["v"] = fieldHex(m_fields[V]);
+    bData["r"] = fieldHex(m_fields[R]);
+    bData["s"] = fieldHex(m_fields[S]);
+    return bData;
+}
+
+BlockView::BlockView(bytesConstRef _rlp) : m_rlp(parse(_rlp)), m_header(m_rlp[0])
+{
+    RLP const transactions = m_rlp[1];
+    if (!transactions.isList())
+        throw RLPException("Transactions RLP is expected to be list!");
+    for (auto const& transaction : transactions)
+        m_transactions.emplace_back(transaction);
+
+    RLP const uncles = m_rlp[2];
+    if (!uncles.isList())
+        throw RLPException("Uncles expected to be list");
+    for (auto const& uncle : uncles)
+        m_uncles.emplace_back(uncle);
+}
+
+RLP BlockView::parse(bytesConstRef _rlp)
+{
+    RLP const rlp(_rlp);
+    if (!rlp.isList())
+        throw RLPException("Block RLP is expected to be list");
+    return rlp;
+}
+
+}  // namespace toolimpl
@@ -0,0 +1,120 @@
+#pragma once
+#include <libdevcore/Address.h>
+#include <libdevcore/RLP.h>
+#include <retesteth/dataObject/DataObject.h>
+#include <vector>
+
+namespace toolimpl
+{
+// Typed views of a raw block RLP. The fields reference the RLP bytes which must outlive the view.
+// Structure is validated once on construction, dev::RLPException is thrown on error.
+
+class BlockHeaderView
+{
+public:
+    BlockHeaderView(dev::RLP const& _rlp);
+
+    dev::bytesConstRef raw() const { return m_raw; }
+    dev::h256 hash() const;
+
+    dev::h256 parentHash() const { return dev::h256(m_fields[ParentHash]); }
+    dev::h256 uncleHash() const { return dev::h256(m_fields[UncleHash]); }
+    dev::Address coinbase() const { return dev::Address(m_fields[Coinbase]); }
+    dev::h256 stateRoot() const { return dev::h256(m_fields[StateRoot]); }
+    dev::h256 transactionsTrie() const { return dev::h256(m_fields[TransactionsTrie]); }
+    dev::h256 receiptTrie() const { return dev::h256(m_fields[ReceiptTrie]); }
+    dev::h2048 bloom() const { return dev::h2048(m_fields[Bloom]); }
+    dev::u256 difficulty() const { return dev::fromBigEndian<dev::u256>(m_fields[Difficulty]); }
+    dev::u256 number() const { return dev::fromBigEndian<dev::u256>(m_fields[Number]); }
+    dev::u256 gasLimit() const { return dev::fromBigEndian<dev::u256>(m_fields[GasLimit]); }
+    dev::u256 gasUsed() const { return dev::fromBigEndian<dev::u256>(m_fields[GasUsed]); }
+    dev::u256 timestamp() const { return dev::fromBigEndian<dev::u256>(m_fields[Timestamp]); }
+    dev::bytesConstRef extraData() const { return m_fields[ExtraData]; }
+    dev::h256 mixHash() const { return dev::h256(m_fields[MixHash]); }
+    dev::h64 nonce() const { return dev::h64(m_fields[Nonce]); }
+
+    // Header json of the rpc block, with the hash of the raw rlp
+    dataobject::DataObject toData() const;
+
+private:
+    enum Field
+    {
+        ParentHash,
+        UncleHash,
+        Coinbase,
+        StateRoot,
+        TransactionsTrie,
+        ReceiptTrie,
+        Bloom,
+        Difficulty,
+        Number,
+        GasLimit,
+        GasUsed,
+        Timestamp,
+        ExtraData,
+        MixHash,
+        Nonce,
+        FieldCount
+    };
+    dev::bytesConstRef m_raw;
+    dev::bytesConstRef m_fields[FieldCount];
+};
+
+class TransactionView
+{
+public:
+    TransactionView(dev::RLP const& _rlp);
+
+    dev::bytesConstRef raw() const { return m_raw; }
+    dev::h256 hash() const;
+
+    dev::u256 nonce() const { return dev::fromBigEndian<dev::u256>(m_fields[Nonce]); }
+    dev::u256 gasPrice() const { return dev::fromBigEndian<dev::u256>(m_fields[GasPrice]); }
+    dev::u256 gasLimit() const { return dev::fromBigEndian<dev::u256>(m_fields[GasLimit]); }
+    dev::bytesConstRef to() const { return m_fields[To]; }  // empty for contract creation
+    dev::u256 value() const { return dev::fromBigEndian<dev::u256>(m_fields[Value]); }
+    dev::bytesConstRef data() const { return m_fields[Data]; }
+    dev::u256 v() const { return dev::fromBigEndian<dev::u256>(m_fields[V]); }
+    dev::u256 r() const { return dev::fromBigEndian<dev::u256>(m_fields[R]); }
+    dev::u256 s() const { return dev::fromBigEndian<dev::u256>(m_fields[S]); }
+
+    // Transaction json as it is sent to the tool
+    dataobject::DataObject toData() const;
+
+private:
+    enum Field
+    {
+        Nonce,
+        GasPrice,
+        GasLimit,
+        To,
+        Value,
+        Data,
+        V,
+        R,
+        S,
+        FieldCount
+    };
+    dev::bytesConstRef m_raw;
+    dev::bytesConstRef m_fields[FieldCount];
+};
+
+// Block rlp: header, transactions, uncles
+class BlockView
+{
+public:
+    BlockView(dev::bytesConstRef _rlp);
+
+    BlockHeaderView const& header() const { return m_header; }
+    std::vector<TransactionView> const& transactions() const { return m_transactions; }
+    std::vector<BlockHeaderView> const& uncles() const { return m_uncles; }
+
+private:
+    static dev::RLP parse(dev::bytesConstRef _rlp);
+    dev::RLP m_rlp;
+    BlockHeaderView m_header;
+    std::vector<TransactionView> m_transactions;
+    std::vector<BlockHeaderView> m_uncles;
+};
+
+}  // namespace toolimpl
@@ -4,6 +4,7 @@
 #include <thread>
 
 #include <dataObject/ConvertFile.h>
+#include <retesteth/TestTrace.h>
 #include <retesteth/ethObjects/common.h>
 #include <retesteth/session/RPCImpl.h>
 
@@ -15,6 +16,7 @@ std::string RPCImpl::web3_clientVersion()
 // ETH Methods
 std::string RPCImpl::eth_sendRawTransaction(scheme_transaction const& _transaction)
 {
+    PhaseTimer timer(TestPhase::SendTransaction);
     DataObject result =
         rpcCall("eth_sendRawTransaction", {quote(_transaction.getSignedRLP())}, true);
 
@@ -93,6 +95,7 @@ scheme_debugTraceTransaction RPCImpl::debug_traceTransaction(std::string const&
 // Test
 void RPCImpl::test_setChainParams(DataObject const& _config)
 {
+    PhaseTimer timer(TestPhase::SetChainParams);
     ETH_FAIL_REQUIRE_MESSAGE(rpcCall("test_setChainParams", {_config.asJson()}) == true,
         "remote test_setChainParams = false");
 }
@@ -111,6 +114,7 @@ void RPCImpl::test_modifyTimestamp(unsigned long long _timestamp)
 
 string RPCImpl::test_mineBlocks(int _number, bool _canFail)
 {
+    PhaseTimer timer(TestPhase::Mine);
     DataObject blockNumber = rpcCall("eth_blockNumber");
     u256 startBlock = (blockNumber.type() == DataType::String) ? u256(blockNumber.asString()) :
                                                                  blockNumber.asInt();
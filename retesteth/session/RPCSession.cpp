@@ -58,11 +58,12 @@ struct sessionInfo
     test::ClientConfigID configId;
 };
 
-void closeSession(const string& _threadID);
+void closeSession(size_t _threadID);
+void closeSessionInfo(sessionInfo& _element);
 
 std::mutex g_socketMapMutex;
-static std::map<std::string, sessionInfo> socketMap;  // ! make inside a class static
-void RPCSession::runNewInstanceOfAClient(string const& _threadID, ClientConfig const& _config)
+static std::map<size_t, sessionInfo> socketMap;  // ! make inside a class static
+void RPCSession::runNewInstanceOfAClient(size_t _threadID, ClientConfig const& _config)
 {
     if (_config.getSocketType() == Socket::IPC)
     {
@@ -99,7 +100,7 @@ void RPCSession::runNewInstanceOfAClient(string const& _threadID, ClientConfig c
         {
             std::lock_guard<std::mutex> lock(g_socketMapMutex);  // function must be called from
                                                                  // lock
-            socketMap.insert(std::pair<string, sessionInfo>(_threadID, std::move(info)));
+            socketMap.insert(std::pair<size_t, sessionInfo>(_threadID, std::move(info)));
         }
     }
     else if (_config.getSocketType() == Socket::TCP)
@@ -128,7 +129,7 @@ void RPCSession::runNewInstanceOfAClient(string const& _threadID, ClientConfig c
                 sessionInfo info(NULL,
                     new RPCSession(new RPCImpl(Socket::SocketType::TCP, addr.asString())), "", 0,
                     _config.getId());
-                socketMap.insert(std::pair<string, sessionInfo>(_threadID, std::move(info)));
+                socketMap.insert(std::pair<size_t, sessionInfo>(_threadID, std::move(info)));
                 return;
             }
         }
@@ -145,7 +146,7 @@ void RPCSession::runNewInstanceOfAClient(string const& _threadID, ClientConfig c
         {
             std::lock_guard<std::mutex> lock(g_socketMapMutex);  // function must be called from
                                                                  // lock
-            socketMap.insert(std::pair<string, sessionInfo>(_threadID, std::move(info)));
+            socketMap.insert(std::pair<size_t, sessionInfo>(_threadID, std::move(info)));
         }
     }
     else if (_config.getSocketType() == Socket::TransitionTool)
@@ -154,29 +155,41 @@ void RPCSession::runNewInstanceOfAClient(string const& _threadID, ClientConfig c
             new RPCSession(new ToolImpl(Socket::SocketType::TCP, _config.getAddress())), "", 0,
             _config.getId());
         std::lock_guard<std::mutex> lock(g_socketMapMutex);  // function must be called from lock
-        socketMap.insert(std::pair<string, sessionInfo>(_threadID, std::move(info)));
+        socketMap.insert(std::pair<size_t, sessionInfo>(_threadID, std::move(info)));
         return;
     }
     else
         ETH_FAIL_MESSAGE("Unknown Socket Type in runNewInstanceOfAClient");
 }
 
-SessionInterface& RPCSession::instance(const string& _threadID)
+SessionInterface& RPCSession::instance(size_t _threadID)
 {
     bool needToCreateNew = false;
+    std::unique_ptr<sessionInfo> releasedSession;
     {
         std::lock_guard<std::mutex> lock(g_socketMapMutex);
         test::ClientConfigID currentConfigId =
             Options::getDynamicOptions().getCurrentConfig().getId();
         if (socketMap.count(_threadID) && socketMap.at(_threadID).configId != currentConfigId)
         {
-            // For this thread a session is opened but it is opened not for current tested client
-            ETH_FAIL_MESSAGE("A session opened for another client id!");
+            // A session released by this thread when it tested another client is closed,
+            // the thread connects to the current client instead
+            if (socketMap.at(_threadID).isUsed == SessionStatus::Available)
+            {
+                releasedSession.reset(new sessionInfo(std::move(socketMap.at(_threadID))));
+                socketMap.erase(_threadID);
+            }
+            else
+            {
+                // For this thread a session is opened but it is opened not for current tested client
+                ETH_FAIL_MESSAGE("A session opened for another client id!");
+            }
         }
 
         if (!socketMap.count(_threadID))
         {
             // look for free clients that already instantiated
+            needToCreateNew = true;
             for (auto& socket : socketMap)
             {
                 if (socket.second.isUsed == SessionStatus::Available)
@@ -184,15 +197,17 @@ SessionInterface& RPCSession::instance(const string& _threadID)
                     {
                         socket.second.isUsed = SessionStatus::Working;
                         socketMap.insert(
-                            std::pair<string, sessionInfo>(_threadID, std::move(socket.second)));
+                            std::pair<size_t, sessionInfo>(_threadID, std::move(socket.second)));
                         socketMap.erase(socketMap.find(socket.first));  // remove previous threadID
                                                                         // assigment to this socket
-                        return socketMap.at(_threadID).session.get()->getImplementation();
+                        needToCreateNew = false;
+                        break;
                     }
             }
-            needToCreateNew = true;
         }
     }
+    if (releasedSession)
+        closeSessionInfo(*releasedSession);
     if (needToCreateNew)
         runNewInstanceOfAClient(_threadID, Options::getDynamicOptions().getCurrentConfig());
 
@@ -204,7 +219,7 @@ SessionInterface& RPCSession::instance(const string& _threadID)
     return socketMap.at(_threadID).session.get()->getImplementation();
 }
 
-void RPCSession::sessionStart(std::string const& _threadID)
+void RPCSession::sessionStart(size_t _threadID)
 {
     RPCSession::instance(_threadID);  // initialize the client if not exist
     std::lock_guard<std::mutex> lock(g_socketMapMutex);
@@ -212,7 +227,7 @@ void RPCSession::sessionStart(std::string const& _threadID)
         socketMap.at(_threadID).isUsed = SessionStatus::Working;
 }
 
-void RPCSession::sessionEnd(std::string const& _threadID, SessionStatus _status)
+void RPCSession::sessionEnd(size_t _threadID, SessionStatus _status)
 {
     std::lock_guard<std::mutex> lock(g_socketMapMutex);
     assert(socketMap.count(_threadID));
@@ -220,7 +235,7 @@ void RPCSession::sessionEnd(std::string const& _threadID, SessionStatus _status)
         socketMap.at(_threadID).isUsed = _status;
 }
 
-RPCSession::SessionStatus RPCSession::sessionStatus(std::string const& _threadID)
+RPCSession::SessionStatus RPCSession::sessionStatus(size_t _threadID)
 {
     std::lock_guard<std::mutex> lock(g_socketMapMutex);
     if (socketMap.count(_threadID))
@@ -228,17 +243,21 @@ RPCSession::SessionStatus RPCSession::sessionStatus(std::string const& _threadID
     return RPCSession::NotExist;
 }
 
-void closeSession(const string& _threadID)
+void closeSession(size_t _threadID)
 {
     ETH_FAIL_REQUIRE_MESSAGE(socketMap.count(_threadID), "Socket map is empty in closeSession!");
-    sessionInfo& element = socketMap.at(_threadID);
-    if (element.session.get()->getImplementation().getSocketType() == Socket::SocketType::IPC)
+    closeSessionInfo(socketMap.at(_threadID));
+}
+
+void closeSessionInfo(sessionInfo& _element)
+{
+    if (_element.session.get()->getImplementation().getSocketType() == Socket::SocketType::IPC)
     {
-        test::pclose2(element.filePipe.get(), element.pipePid);
+        test::pclose2(_element.filePipe.get(), _element.pipePid);
         std::this_thread::sleep_for(std::chrono::seconds(4));
-        boost::filesystem::remove_all(boost::filesystem::path(element.tmpDir));
-        element.filePipe.release();
-        element.session.release();
+        boost::filesystem::remove_all(boost::filesystem::path(_element.tmpDir));
+        _element.filePipe.release();
+        _element.session.release();
     }
 }
 
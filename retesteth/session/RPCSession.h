@@ -21,10 +21,10 @@ public:
         NotExist      // socket yet not initialized
     };
 
-    static SessionInterface& instance(std::string const& _threadID);
-    static void sessionStart(std::string const& _threadID);
-    static void sessionEnd(std::string const& _threadID, SessionStatus _status);
-    static SessionStatus sessionStatus(std::string const& _threadID);
+    static SessionInterface& instance(size_t _threadID);
+    static void sessionStart(size_t _threadID);
+    static void sessionEnd(size_t _threadID, SessionStatus _status);
+    static SessionStatus sessionStatus(size_t _threadID);
     static void clear();
 
     SessionInterface& getImplementation() { return *m_implementation; }
@@ -32,7 +32,7 @@ public:
 
 private:
     explicit RPCSession(SessionInterface* _impl);
-    static void runNewInstanceOfAClient(std::string const& _threadID, ClientConfig const& _config);
+    static void runNewInstanceOfAClient(size_t _threadID, ClientConfig const& _config);
     SessionInterface* m_implementation;
 
     /// Parse std::string replacing keywords to values
@@ -36,6 +36,15 @@ public:
     virtual string test_importRawBlock(std::string const& _blockRLP) = 0;
     virtual std::string test_getLogHash(std::string const& _txHash) = 0;
 
+    // Each of _transactions is going to be mined alone in block 1 on top of the current genesis.
+    // Sessions that execute blocks locally (t8n tool) may calculate the blocks in parallel
+    virtual void test_prepareSingleTransactionBlocks(
+        std::vector<scheme_transaction> const& _transactions, unsigned long long _timestamp)
+    {
+        (void)_transactions;
+        (void)_timestamp;
+    }
+
     // Internal
     virtual DataObject rpcCall(std::string const& _methodName,
         std::vector<std::string> const& _args = std::vector<std::string>(),
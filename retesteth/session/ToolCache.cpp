@@ -0,0 +1,302 @@
+#include <algorithm>
+
+#include <dataObject/ConvertFile.h>
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/FileSystem.h>
+#include <libdevcore/SHA3.h>
+#include <retesteth/EthChecks.h>
+#include <retesteth/Options.h>
+#include <retesteth/session/ToolCache.h>
+
+using namespace std;
+using namespace test;
+
+namespace toolimpl
+{
+string toolIdentity(fs::path const& _toolPath)
+{
+    string identity = _toolPath.string();
+    boost::system::error_code ec;
+    uintmax_t const size = fs::file_size(_toolPath, ec);
+    if (!ec)
+        identity += ":" + toString(size);
+    time_t const mtime = fs::last_write_time(_toolPath, ec);
+    if (!ec)
+        identity += ":" + toString(mtime);
+    return identity;
+}
+
+string canonicalJson(DataObject const& _obj)
+{
+    if (_obj.type() != DataType::Object)
+        return _obj.asJson(0, false);
+
+    vector<DataObject const*> sorted;
+    for (auto const& el : _obj.getSubObjects())
+        sorted.push_back(&el);
+    std::sort(sorted.begin(), sorted.end(),
+        [](DataObject const* _a, DataObject const* _b) { return _a->getKey() < _b->getKey(); });
+
+    string json = _obj.getKey().empty() ? "{" : "\"" + _obj.getKey() + "\":{";
+    for (size_t i = 0; i < sorted.size(); i++)
+    {
+        json += canonicalJson(*sorted.at(i));
+        if (i + 1 != sorted.size())
+            json += ",";
+    }
+    return json + "}";
+}
+
+namespace
+{
+// Genesis blocks kept in memory. Hits are within one test (its transactions and forks)
+size_t const c_genesisCacheMaxEntries = 64;
+}  // namespace
+
+GenesisCache& GenesisCache::get()
+{
+    static GenesisCache instance;
+    return instance;
+}
+
+GenesisCache::GenesisCache()
+{
+    if (Options::get().genesiscache)
+    {
+        m_cacheDir = getRetestethDataDir() / "cache" / "genesis";
+        fs::create_directories(m_cacheDir);
+    }
+}
+
+string GenesisCache::makeKey(string const& _toolPath, DataObject const& _chainParams)
+{
+    DataObject const& genesis = _chainParams.atKey("genesis");
+    vector<string> inputs = {_chainParams.atKey("params").atKey("fork").asString()};
+    for (auto const& field : {"author", "difficulty", "gasLimit", "extraData", "timestamp"})
+        inputs.push_back(genesis.atKey(field).asString());
+    inputs.push_back(canonicalJson(_chainParams.atKey("accounts")));
+
+    string key = toolIdentity(_toolPath);
+    for (auto const& input : inputs)
+        key += toString(input.size()) + ":" + input;
+    return toString(dev::sha3(key));
+}
+
+bool GenesisCache::find(string const& _key, GenesisCacheEntry& _entry)
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    auto const it = m_cache.find(_key);
+    if (it != m_cache.end())
+    {
+        m_lru.splice(m_lru.begin(), m_lru, it->second.lruPos);
+        _entry = it->second.entry;
+        return true;
+    }
+
+    if (m_cacheDir.empty())
+        return false;
+    fs::path const entryPath = m_cacheDir / (_key + ".json");
+    if (!fs::exists(entryPath))
+        return false;
+
+    // an entry broken by a crash or a disk error is generated again
+    DataObject stored;
+    try
+    {
+        stored = ConvertJsoncppStringToData(dev::contentsString(entryPath));
+    }
+    catch (std::exception const& _ex)
+    {
+        ETH_WARNING("Ignoring genesis cache entry '" + entryPath.string() + "': " + _ex.what());
+        return false;
+    }
+    for (auto const& field : {"block", "header", "state", "logsHash"})
+        if (!stored.count(field))
+        {
+            ETH_WARNING("Ignoring genesis cache entry '" + entryPath.string() +
+                        "': missing field " + field);
+            return false;
+        }
+
+    _entry.rpcBlock = stored.atKey("block");
+    _entry.rpcBlock.setKey(string());
+    _entry.header = stored.atKey("header");
+    _entry.header.setKey(string());
+    _entry.postState = stored.atKey("state");
+    _entry.postState.setKey(string());
+    _entry.logsHash = stored.atKey("logsHash").asString();
+    remember(_key, _entry);
+    return true;
+}
+
+void GenesisCache::add(string const& _key, GenesisCacheEntry const& _entry)
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    if (m_cache.count(_key))
+        return;
+    remember(_key, _entry);
+    if (m_cacheDir.empty())
+        return;
+
+    DataObject stored;
+    stored["block"] = _entry.rpcBlock;
+    stored["header"] = _entry.header;
+    stored["state"] = _entry.postState;
+    stored["logsHash"] = _entry.logsHash;
+    // written to a unique temp file and renamed, other instances never read half written entry
+    try
+    {
+        dev::writeFile(m_cacheDir / (_key + ".json"), stored.asJson(0, false), true);
+    }
+    catch (std::exception const& _ex)
+    {
+        ETH_WARNING("Failed to store genesis cache entry '" + _key + "': " + _ex.what());
+    }
+}
+
+void GenesisCache::remember(string const& _key, GenesisCacheEntry const& _entry)
+{
+    m_lru.push_front(_key);
+    m_cache[_key] = {_entry, m_lru.begin()};
+    if (m_lru.size() > c_genesisCacheMaxEntries)
+    {
+        m_cache.erase(m_lru.back());
+        m_lru.pop_back();
+    }
+}
+
+}  // namespace toolimpl
+
+namespace
+{
+fs::path resultPath(fs::path const& _dir, string const& _key)
+{
+    return _dir / (_key + ".out.json");
+}
+fs::path allocPath(fs::path const& _dir, string const& _key)
+{
+    return _dir / (_key + ".alloc.json");
+}
+void copyEntryFile(fs::path const& _from, fs::path const& _to)
+{
+    // write via rename so other retesteth instances never read half written entry
+    // the temp name is unique, threads and instances may store the same entry at once
+    fs::path const tmpPath = dev::uniqueTempPath(_to);
+    try
+    {
+        fs::copy_file(_from, tmpPath);
+        fs::rename(tmpPath, _to);
+    }
+    catch (...)
+    {
+        boost::system::error_code ec;
+        fs::remove(tmpPath, ec);
+        throw;
+    }
+}
+}  // namespace
+
+namespace toolimpl
+{
+ToolResultCache& ToolResultCache::get()
+{
+    static ToolResultCache instance;
+    return instance;
+}
+
+ToolResultCache::ToolResultCache()
+{
+    Options const& opt = Options::get();
+    if (!opt.t8ncache)
+        return;
+
+    m_cacheDir = getRetestethDataDir() / "cache" / "t8n";
+    m_maxSize = opt.t8ncacheSize * 1024 * 1024;
+    fs::create_directories(m_cacheDir);
+    for (fs::directory_iterator it(m_cacheDir); it != fs::directory_iterator(); it++)
+        if (fs::is_regular_file(it->path()))
+            m_totalSize += fs::file_size(it->path());
+    evictOldEntries();
+}
+
+string ToolResultCache::makeKey(string const& _toolPath, string const& _fork,
+    string const& _reward, string const& _alloc, string const& _txs, string const& _env)
+{
+    string key = toolIdentity(_toolPath);
+    for (auto const* input : {&_fork, &_reward, &_alloc, &_txs, &_env})
+        key += toString(input->size()) + ":" + *input;
+    return toString(dev::sha3(key));
+}
+
+bool ToolResultCache::find(string const& _key, fs::path const& _outPath, fs::path const& _outAllocPath)
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    fs::path const cachedResult = resultPath(m_cacheDir, _key);
+    fs::path const cachedAlloc = allocPath(m_cacheDir, _key);
+    if (!fs::exists(cachedResult) || !fs::exists(cachedAlloc))
+        return false;
+
+    size_t const verifyEach = Options::get().t8ncacheVerify;
+    if (verifyEach > 0 && ++m_hits % verifyEach == 0)
+    {
+        ETH_LOG("t8n cache verification, execute the tool for entry: " + _key, 6);
+        return false;
+    }
+
+    fs::copy_file(cachedResult, _outPath, fs::copy_option::overwrite_if_exists);
+    fs::copy_file(cachedAlloc, _outAllocPath, fs::copy_option::overwrite_if_exists);
+
+    // last write time is the eviction order
+    time_t const now = time(nullptr);
+    fs::last_write_time(cachedResult, now);
+    fs::last_write_time(cachedAlloc, now);
+    return true;
+}
+
+void ToolResultCache::add(string const& _key, fs::path const& _outPath, fs::path const& _outAllocPath)
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    fs::path const cachedResult = resultPath(m_cacheDir, _key);
+    fs::path const cachedAlloc = allocPath(m_cacheDir, _key);
+    if (fs::exists(cachedResult) && fs::exists(cachedAlloc))
+    {
+        if (dev::contentsString(cachedResult) == dev::contentsString(_outPath) &&
+            dev::contentsString(cachedAlloc) == dev::contentsString(_outAllocPath))
+            return;
+        ETH_WARNING("t8n tool returned different output for the same input (tool is not "
+                    "deterministic?), replacing t8n cache entry: " +
+                    _key);
+        m_totalSize -= std::min<size_t>(
+            m_totalSize, fs::file_size(cachedResult) + fs::file_size(cachedAlloc));
+    }
+
+    copyEntryFile(_outPath, cachedResult);
+    copyEntryFile(_outAllocPath, cachedAlloc);
+    m_totalSize += fs::file_size(cachedResult) + fs::file_size(cachedAlloc);
+    evictOldEntries();
+}
+
+void ToolResultCache::evictOldEntries()
+{
+    if (m_totalSize <= m_maxSize)
+        return;
+
+    // Remove least recently used entries until the cache is at 90% of the limit
+    vector<std::pair<time_t, fs::path>> entries;
+    for (fs::directory_iterator it(m_cacheDir); it != fs::directory_iterator(); it++)
+        if (fs::is_regular_file(it->path()))
+            entries.push_back({fs::last_write_time(it->path()), it->path()});
+    std::sort(entries.begin(), entries.end());
+
+    size_t const targetSize = m_maxSize / 10 * 9;
+    for (auto const& entry : entries)
+    {
+        if (m_totalSize <= targetSize)
+            break;
+        m_totalSize -= std::min<size_t>(m_totalSize, fs::file_size(entry.second));
+        fs::remove(entry.second);
+    }
+    ETH_LOG("t8n cache evicted old entries, cache size: " + toString(m_totalSize), 6);
+}
+
+}  // namespace toolimpl
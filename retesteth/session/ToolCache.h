@@ -0,0 +1,89 @@
+#pragma once
+#include <retesteth/dataObject/DataObject.h>
+#include <boost/filesystem.hpp>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+
+using namespace dataobject;
+namespace fs = boost::filesystem;
+namespace toolimpl
+{
+// Tool binary identity (path, size, last write time). Results of the tool are only valid for the
+// same binary, so this is a part of every cache key
+std::string toolIdentity(fs::path const& _toolPath);
+
+// Json string of the object with all object keys sorted, so equal states give equal strings
+std::string canonicalJson(DataObject const& _obj);
+
+// Genesis block calculated by the tool for the pre state
+struct GenesisCacheEntry
+{
+    DataObject rpcBlock;   // scheme_RPCBlock data of the genesis block
+    DataObject header;     // Genesis block header as set by test_setChainParams
+    DataObject postState;  // Genesis alloc as returned by the tool
+    std::string logsHash;
+};
+
+// Process wide cache of genesis blocks shared by all ToolImpl sessions
+// test_setChainParams needs the tool only to calculate the genesis stateRoot, which is the same
+// for every transaction of the state test. Only the recently used genesis blocks are kept in
+// memory, with --genesiscache entries are stored in datadir for the reuse across tests
+class GenesisCache
+{
+public:
+    static GenesisCache& get();
+
+    // (tool, fork, genesis header fields, canonical accounts) of the test_setChainParams config
+    static std::string makeKey(std::string const& _toolPath, DataObject const& _chainParams);
+
+    bool find(std::string const& _key, GenesisCacheEntry& _entry);
+    void add(std::string const& _key, GenesisCacheEntry const& _entry);
+
+private:
+    GenesisCache();
+    void remember(std::string const& _key, GenesisCacheEntry const& _entry);
+
+    struct CachedEntry
+    {
+        GenesisCacheEntry entry;
+        std::list<std::string>::iterator lruPos;
+    };
+    fs::path m_cacheDir;  // empty if not persistent
+    std::mutex m_cacheMutex;
+    std::map<std::string, CachedEntry> m_cache;
+    std::list<std::string> m_lru;  // keys of m_cache, most recently used first
+};
+
+// Persistent cache of t8n tool results (--t8ncache) in <datadir>/cache/t8n
+// Tool outputs are fully defined by the tool binary and alloc, txs, env, fork, reward inputs
+class ToolResultCache
+{
+public:
+    static ToolResultCache& get();
+    bool isEnabled() const { return !m_cacheDir.empty(); }
+
+    static std::string makeKey(std::string const& _toolPath, std::string const& _fork,
+        std::string const& _reward, std::string const& _alloc, std::string const& _txs,
+        std::string const& _env);
+
+    // Copy cached result and alloc into _outPath, _outAllocPath. Returns false if there is no
+    // entry or if the entry is sampled for verification (--t8ncacheverify)
+    bool find(std::string const& _key, fs::path const& _outPath, fs::path const& _outAllocPath);
+
+    // Store tool outputs. If the entry exists it must be the same, otherwise tool is not
+    // deterministic and the entry is replaced
+    void add(std::string const& _key, fs::path const& _outPath, fs::path const& _outAllocPath);
+
+private:
+    ToolResultCache();
+    void evictOldEntries();
+    fs::path m_cacheDir;  // empty if cache is disabled
+    std::mutex m_cacheMutex;
+    size_t m_totalSize = 0;
+    size_t m_maxSize = 0;
+    size_t m_hits = 0;
+};
+
+}  // namespace toolimpl
@@ -1,13 +1,64 @@
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdio>
+#include <cstdlib>
+#include <mutex>
 #include <thread>
 
 #include <dataObject/ConvertFile.h>
+#include <retesteth/TestTrace.h>
 #include <retesteth/ethObjects/common.h>
+#include <retesteth/session/ToolCache.h>
 #include <retesteth/session/ToolImpl.h>
 #include <retesteth/session/ToolImplHelper.h>
 using namespace toolimpl;
 
+namespace
+{
+// Counting semaphore for the tool processes of --t8nbatch. Shared by all sessions, so
+// -j workers together run at most t8nbatch tool processes
+class ToolProcessLimit
+{
+public:
+    static ToolProcessLimit& get()
+    {
+        static ToolProcessLimit instance(Options::get().t8nbatch);
+        return instance;
+    }
+
+    void acquire()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_released.wait(lock, [this]() { return m_free > 0; });
+        m_free--;
+    }
+
+    void release()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_free++;
+        }
+        m_released.notify_one();
+    }
+
+private:
+    explicit ToolProcessLimit(size_t _processes) : m_free(std::max<size_t>(1, _processes)) {}
+    std::mutex m_mutex;
+    std::condition_variable m_released;
+    size_t m_free;
+};
+
+// Holds a tool process slot for the scope
+class ToolProcessSlot
+{
+public:
+    ToolProcessSlot() { ToolProcessLimit::get().acquire(); }
+    ~ToolProcessSlot() { ToolProcessLimit::get().release(); }
+};
+}  // namespace
+
 std::string ToolImpl::web3_clientVersion()
 {
     rpcCall("", {});
@@ -19,6 +70,7 @@ std::string ToolImpl::web3_clientVersion()
 // perhaps take raw rlp instead ??
 std::string ToolImpl::eth_sendRawTransaction(scheme_transaction const& _transaction)
 {
+    PhaseTimer timer(TestPhase::SendTransaction);
     rpcCall("", {});
     ETH_TEST_MESSAGE("Request: eth_sendRawTransaction \n" + _transaction.getData().asJson());
     m_transactions.push_back(_transaction);
@@ -204,6 +256,7 @@ scheme_debugTraceTransaction ToolImpl::debug_traceTransaction(std::string const&
 // Test
 void ToolImpl::test_setChainParams(DataObject const& _config)
 {
+    PhaseTimer timer(TestPhase::SetChainParams);
     m_chainGenesis.clear();
     m_chainParams.clear();
     m_transactions.clear();
@@ -271,6 +324,22 @@ void ToolImpl::test_setChainParams(DataObject const& _config)
     size_t const cchID = m_current_chain_ind;
     size_t const beginSize = m_blockchainMap[m_current_chain_ind].size();
     ETH_ERROR_REQUIRE_MESSAGE(beginSize == 0, "test_setChain params currChain size must be 0");
+
+    // The same pre state is set for every transaction of a state test, ask the tool only once
+    string const genesisKey = GenesisCache::makeKey(m_toolPath, m_chainParams);
+    GenesisCacheEntry cachedGenesis;
+    if (GenesisCache::get().find(genesisKey, cachedGenesis))
+    {
+        m_currentBlockHeader.isMiningGenesis = false;
+        scheme_RPCBlock genesisRPC(cachedGenesis.rpcBlock);
+        genesisRPC.setLogsHash(cachedGenesis.logsHash);
+        ToolBlock genesis(genesisRPC, m_chainParams, cachedGenesis.postState);
+        genesis.overwriteBlockHeader(cachedGenesis.header);
+        m_chainGenesis.push_back(genesis);
+        ETH_TEST_MESSAGE("Response test_setChainParams: {true} (genesis cache " + genesisKey + ")");
+        return;
+    }
+
     test_mineBlocks(1);  // use tool to calculate the hash of genesis pre state (must work, fail on
                          // error)
     ETH_ERROR_REQUIRE_MESSAGE(
@@ -288,6 +357,12 @@ void ToolImpl::test_setChainParams(DataObject const& _config)
     // remove fake block which is actually genesis
     m_blockchainMap.at(m_current_chain_ind).pop_back();
 
+    cachedGenesis.rpcBlock = genesis.getRPCResponse().getData();
+    cachedGenesis.header = genesis.getRPCResponse().getBlockHeader();
+    cachedGenesis.postState = genesis.getPostState();
+    cachedGenesis.logsHash = genesis.getRPCResponse().getLogsHash();
+    GenesisCache::get().add(genesisKey, cachedGenesis);
+
     ETH_TEST_MESSAGE("Response test_setChainParams: {true}");
     ETH_TEST_MESSAGE(genesis.getRPCResponse().getBlockHeader().asJson());
 }
@@ -372,10 +447,10 @@ string ToolImpl::prepareEnvForTool() const
 
     return env.asJson();
 }
-string ToolImpl::prepareTxsForTool() const
+string ToolImpl::prepareTxsForTool(std::list<scheme_transaction> const& _transactions) const
 {
     DataObject txs(DataType::Array);
-    for (auto const& tx : m_transactions)
+    for (auto const& tx : _transactions)
     {
         DataObject txToolFormat = tx.getDataForBCTest();
         txToolFormat.performModifier(test::mod_removeLeadingZerosFromHexValues);
@@ -400,9 +475,150 @@ static std::map<string, string> RewardMapForToolAfter5 = {{"FrontierToHomesteadA
     {"HomesteadToEIP150At5", "EIP150"}, {"EIP158ToByzantiumAt5", "Byzantium"},
     {"HomesteadToDaoAt5", "Homestead"}, {"ByzantiumToConstantinopleFixAt5", "ConstantinopleFix"}};
 
+string ToolImpl::prepareRewardForTool() const
+{
+    // If calculating geneis block disable rewards. so to see the state root hash
+    if (m_currentBlockHeader.isMiningGenesis ||
+        m_chainParams.atKey("sealEngine").asString() != "NoProof")
+        return string();
+
+    // Setup mining rewards
+    DataObject const& rewards =
+        Options::get().getDynamicOptions().getCurrentConfig().getMiningRewardInfo();
+    string const& fork = m_chainParams.atKey("params").atKey("fork").asString();
+    if (rewards.count(fork))
+        return rewards.atKey(fork).asString();
+    if (m_currentBlockHeader.currentBlockNumber < 5)
+        return rewards.atKey(RewardMapForToolBefore5.at(fork)).asString();
+    return rewards.atKey(RewardMapForToolAfter5.at(fork)).asString();
+}
+
+// Tool reads txs.json and writes out.json, outAlloc.json in _dir
+string ToolImpl::toolCommand(fs::path const& _allocPath, fs::path const& _envPath,
+    fs::path const& _dir, string const& _reward) const
+{
+    string cmd = string(m_toolPath);
+    cmd += " --input.alloc " + _allocPath.string();
+    cmd += " --input.txs " + (_dir / "txs.json").string();
+    cmd += " --input.env " + _envPath.string();
+    cmd += " --output.result " + (_dir / "out.json").string();
+    cmd += " --output.alloc " + (_dir / "outAlloc.json").string();
+    cmd += " --state.fork " + m_chainParams.atKey("params").atKey("fork").asString();
+    if (!_reward.empty())
+        cmd += " --state.reward " + _reward;
+    return cmd;
+}
+
+string ToolImpl::preparedBlockKey(string const& _trHash, string const& _reward) const
+{
+    // Genesis hash defines the pre state and the block 1 header values
+    return getGenesis().getHash() + m_chainParams.atKey("params").atKey("fork").asString() +
+           _reward + toString(m_currentBlockHeader.timestamp) + _trHash;
+}
+
+void ToolImpl::test_prepareSingleTransactionBlocks(
+    std::vector<scheme_transaction> const& _transactions, unsigned long long _timestamp)
+{
+    m_preparedBlocks.clear();
+    size_t const maxProcesses = Options::get().t8nbatch;
+    if (maxProcesses == 0 || _transactions.size() < 2 || m_chainGenesis.empty() ||
+        getCurrChain().size() != 0)
+        return;
+
+    rpcCall("", {});
+    ETH_TEST_MESSAGE("Request: test_prepareSingleTransactionBlocks " +
+                     toString(_transactions.size()) + " transactions");
+
+    // Same env as test_mineBlocks makes for the block 1 (mine after test_setChainParams)
+    unsigned long long const savedTimestamp = m_currentBlockHeader.timestamp;
+    int const savedNumber = m_currentBlockHeader.currentBlockNumber;
+    string const savedParentHash = m_currentBlockHeader.header.atKey("parentHash").asString();
+    m_currentBlockHeader.timestamp = _timestamp;
+    m_currentBlockHeader.currentBlockNumber = 1;
+    m_currentBlockHeader.header["parentHash"] = getGenesis().getHash();
+    string const envJson = prepareEnvForTool();
+    string const allocJson = prepareAllocForTool();
+    string const reward = prepareRewardForTool();
+    vector<string> keys;
+    vector<string> txsJsons;
+    for (auto const& tr : _transactions)
+    {
+        keys.push_back(preparedBlockKey(tr.getHash(), reward));
+        txsJsons.push_back(prepareTxsForTool({tr}));
+    }
+    m_currentBlockHeader.timestamp = savedTimestamp;
+    m_currentBlockHeader.currentBlockNumber = savedNumber;
+    m_currentBlockHeader.header["parentHash"] = savedParentHash;
+
+    // Pre state is serialized once and shared by all tool processes
+    fs::path const batchDir = test::createUniqueTmpDirectory();
+    fs::path const allocPath = batchDir / "alloc.json";
+    fs::path const envPath = batchDir / "env.json";
+    writeFile(allocPath.string(), allocJson);
+    writeFile(envPath.string(), envJson);
+
+    // Tool errors are not reported here. test_mineBlocks executes the tool again if there is
+    // no result for the block and reports the error in test context
+    string const& fork = m_chainParams.atKey("params").atKey("fork").asString();
+    vector<ToolOutput> outputs(_transactions.size());
+    std::atomic<size_t> nextJob(0);
+    auto worker = [&]() {
+        for (size_t i = nextJob++; i < outputs.size(); i = nextJob++)
+        {
+            try
+            {
+                fs::path const jobDir = batchDir / toString(i);
+                fs::path const outPath = jobDir / "out.json";
+                fs::path const outAllocPath = jobDir / "outAlloc.json";
+                fs::create_directory(jobDir);
+                writeFile((jobDir / "txs.json").string(), txsJsons.at(i));
+
+                ToolResultCache& resultCache = ToolResultCache::get();
+                string const cacheKey = resultCache.isEnabled() ?
+                                            ToolResultCache::makeKey(m_toolPath, fork, reward,
+                                                allocJson, txsJsons.at(i), envJson) :
+                                            string();
+                if (!resultCache.isEnabled() || !resultCache.find(cacheKey, outPath, outAllocPath))
+                {
+                    string const cmd = toolCommand(allocPath, envPath, jobDir, reward);
+                    int exitCode = 0;
+                    {
+                        ToolProcessSlot slot;
+                        exitCode = std::system((cmd + " > /dev/null 2>&1").c_str());
+                    }
+                    if (exitCode != 0)
+                        continue;
+                    if (resultCache.isEnabled())
+                        resultCache.add(cacheKey, outPath, outAllocPath);
+                }
+                outputs.at(i).result = contentsString(outPath);
+                outputs.at(i).alloc = contentsString(outAllocPath);
+            }
+            catch (std::exception const&)
+            {
+                outputs.at(i) = ToolOutput();
+            }
+        }
+    };
+
+    vector<std::thread> workers;
+    for (size_t i = 0; i < std::min(maxProcesses, outputs.size()); i++)
+        workers.push_back(std::thread(worker));
+    for (auto& th : workers)
+        th.join();
+    fs::remove_all(batchDir);
+
+    for (size_t i = 0; i < outputs.size(); i++)
+        if (!outputs.at(i).result.empty() && !outputs.at(i).alloc.empty())
+            m_preparedBlocks.emplace(keys.at(i), outputs.at(i));
+    ETH_TEST_MESSAGE("Response test_prepareSingleTransactionBlocks: " +
+                     toString(m_preparedBlocks.size()) + " blocks");
+}
+
 
 string ToolImpl::test_mineBlocks(int _number, bool _canFail)
 {
+    PhaseTimer timer(TestPhase::Mine);
     (void)_canFail;
     rpcCall("", {});
     ETH_TEST_MESSAGE("Request: test_mineBlocks");
@@ -424,72 +640,65 @@ string ToolImpl::test_mineBlocks(int _number, bool _canFail)
             pHash = &getLastBlock().getHash();
         m_currentBlockHeader.header["parentHash"] = *pHash;
     }
-    fs::path envPath = m_tmpDir / "env.json";
-    writeFile(envPath.string(), prepareEnvForTool());
-
-    // txs.json file
-    fs::path txsPath = m_tmpDir / "txs.json";
-    writeFile(txsPath.string(), prepareTxsForTool());
-
-    // alloc.json file
-    fs::path allocPath = m_tmpDir / "alloc.json";
-    writeFile(allocPath.string(), prepareAllocForTool());
-
-    // output file
-    fs::path outPath = m_tmpDir / "out.json";
-    fs::path outAllocPath = m_tmpDir / "outAlloc.json";
-
-    string cmd = string(m_toolPath);
-    cmd += " --input.alloc " + allocPath.string();
-    cmd += " --input.txs " + txsPath.string();
-    cmd += " --input.env " + envPath.string();
-    cmd += " --output.result " + outPath.string();
-    cmd += " --output.alloc " + outAllocPath.string();
-    cmd += " --state.fork " + m_chainParams.atKey("params").atKey("fork").asString();
+    string const envJson = prepareEnvForTool();
+    string const txsJson = prepareTxsForTool(m_transactions);
+    string const allocJson = prepareAllocForTool();
+    string const& fork = m_chainParams.atKey("params").atKey("fork").asString();
+    string const reward = prepareRewardForTool();
 
-    if (!m_currentBlockHeader.isMiningGenesis)  // If calculating geneis block disable rewards. so
-                                                // to see the state root hash
-        if (m_chainParams.atKey("sealEngine").asString() == "NoProof")
+    ETH_TEST_MESSAGE("Alloc:\n" + allocJson);
+    if (m_transactions.size())
+        ETH_TEST_MESSAGE("Txs:\n" + txsJson);
+    ETH_TEST_MESSAGE("Env:\n" + envJson);
+
+    // Block 1 with single transaction might be calculated already
+    ToolOutput output;
+    auto prepared = m_preparedBlocks.end();
+    if (m_transactions.size() == 1 && m_currentBlockHeader.currentBlockNumber == 1 &&
+        !m_currentBlockHeader.isImportRawBlock && m_currentBlockHeader.uncles.empty())
+        prepared =
+            m_preparedBlocks.find(preparedBlockKey(m_transactions.front().getHash(), reward));
+    if (prepared != m_preparedBlocks.end())
+    {
+        ETH_TEST_MESSAGE("Res: precalculated by test_prepareSingleTransactionBlocks");
+        output = prepared->second;
+    }
+    else
+    {
+        fs::path const allocPath = m_tmpDir / "alloc.json";
+        fs::path const envPath = m_tmpDir / "env.json";
+        writeFile(envPath.string(), envJson);
+        writeFile((m_tmpDir / "txs.json").string(), txsJson);
+        writeFile(allocPath.string(), allocJson);
+
+        // Same inputs for the same tool binary give the same outputs
+        fs::path const outPath = m_tmpDir / "out.json";
+        fs::path const outAllocPath = m_tmpDir / "outAlloc.json";
+        ToolResultCache& resultCache = ToolResultCache::get();
+        string const cacheKey = resultCache.isEnabled() ?
+                                    ToolResultCache::makeKey(
+                                        m_toolPath, fork, reward, allocJson, txsJson, envJson) :
+                                    string();
+        if (resultCache.isEnabled() && resultCache.find(cacheKey, outPath, outAllocPath))
+            ETH_TEST_MESSAGE("Res: taken from t8n cache " + cacheKey);
+        else
         {
-            // Setup mining rewards
-            DataObject const& rewards =
-                Options::get().getDynamicOptions().getCurrentConfig().getMiningRewardInfo();
-            string const& fork = m_chainParams.atKey("params").atKey("fork").asString();
-            if (rewards.count(fork))
-            {
-                string const reward = rewards.atKey(fork).asString();
-                cmd += " --state.reward " + reward;
-            }
-            else
-            {
-                if (m_currentBlockHeader.currentBlockNumber < 5)
-                {
-                    string const reward =
-                        rewards.atKey(RewardMapForToolBefore5.at(fork)).asString();
-                    cmd += " --state.reward " + reward;
-                }
-                else
-                {
-                    string const reward = rewards.atKey(RewardMapForToolAfter5.at(fork)).asString();
-                    cmd += " --state.reward " + reward;
-                }
-            }
+            test::executeCmd(toolCommand(allocPath, envPath, m_tmpDir, reward), false);
+            if (resultCache.isEnabled())
+                resultCache.add(cacheKey, outPath, outAllocPath);
         }
-
-    ETH_TEST_MESSAGE("Alloc:\n" + contentsString(allocPath.string()));
-    if (m_transactions.size())
-        ETH_TEST_MESSAGE("Txs:\n" + contentsString(txsPath.string()));
-    ETH_TEST_MESSAGE("Env:\n" + contentsString(envPath.string()));
-    test::executeCmd(cmd, false);
-    ETH_TEST_MESSAGE("Res:\n" + contentsString(outPath.string()));
-    ETH_TEST_MESSAGE("RAlloc:\n" + contentsString(outAllocPath.string()));
+        output.result = contentsString(outPath);
+        output.alloc = contentsString(outAllocPath);
+    }
+    ETH_TEST_MESSAGE("Res:\n" + output.result);
+    ETH_TEST_MESSAGE("RAlloc:\n" + output.alloc);
 
     // Construct block rpc response
-    DataObject const toolResponse = ConvertJsoncppStringToData(contentsString(outPath));
+    DataObject const toolResponse = ConvertJsoncppStringToData(output.result);
     scheme_RPCBlock blockRPC = internalConstructResponseGetBlockByHashOrNumber(toolResponse);
 
-    ToolBlock block(blockRPC, m_chainParams,                        // Env, alloc info
-        ConvertJsoncppStringToData(contentsString(outAllocPath)));  // Result state
+    ToolBlock block(blockRPC, m_chainParams,                 // Env, alloc info
+        ConvertJsoncppStringToData(output.alloc));  // Result state
     if (toolResponse.count("rejected"))
         block.markInvalidTransactions();
 
@@ -537,14 +746,12 @@ string ToolImpl::test_importRawBlock(std::string const& _blockRLP)
     string rawBlockHash;
     try
     {
-        bytes blockBytes = dev::fromHex(_blockRLP);
-        dev::RLP blockRLP(blockBytes);
-        rawBlockHash = dev::toHexPrefixed(dev::sha3(blockRLP[0].data()));
-        if (!blockRLP.isList())
-            throw dev::RLPException("Block RLP is expected to be list");
-
-        BlockHeadFromRLP sanHeader(blockRLP[0]);
-        verifyRawBlock(sanHeader, blockRLP);
+        bytes const blockBytes = dev::fromHex(_blockRLP);
+        BlockView const block(&blockBytes);
+        rawBlockHash = dev::toHexPrefixed(block.header().hash());
+
+        BlockHeadFromRLP sanHeader(block.header());
+        verifyRawBlock(sanHeader, block);
 
         test_mineBlocks(1);
 
@@ -42,6 +42,9 @@ public:
     void test_rewindToBlock(size_t _blockNr) override;
     void test_modifyTimestamp(unsigned long long _timestamp) override;
     string test_mineBlocks(int _number, bool _canFail = false) override;
+    void test_prepareSingleTransactionBlocks(
+        std::vector<scheme_transaction> const& _transactions,
+        unsigned long long _timestamp) override;
     string test_importRawBlock(std::string const& _blockRLP) override;
     std::string test_getLogHash(std::string const& _txHash) override;
 
@@ -85,10 +88,13 @@ private:
 
     // Helper functions
     string prepareAllocForTool() const;
-    string prepareTxsForTool() const;
+    string prepareTxsForTool(std::list<scheme_transaction> const& _transactions) const;
     string prepareEnvForTool() const;
+    string prepareRewardForTool() const;
+    string toolCommand(fs::path const& _allocPath, fs::path const& _envPath, fs::path const& _dir,
+        string const& _reward) const;
     ToolBlock const& getBlockByHashOrNumber(string const&) const;
-    void verifyRawBlock(toolimpl::BlockHeadFromRLP const&, dev::RLP const&);
+    void verifyRawBlock(toolimpl::BlockHeadFromRLP const&, toolimpl::BlockView const&);
 
     // Construct RPC like block response
     struct BlockHeaderOverride;
@@ -122,6 +128,15 @@ private:
     // std::vector<ToolBlock> m_blockchain;
     std::list<scheme_transaction> m_transactions;
 
+    // Tool outputs of blocks calculated by test_prepareSingleTransactionBlocks
+    struct ToolOutput
+    {
+        string result;  // out.json
+        string alloc;   // outAlloc.json
+    };
+    string preparedBlockKey(string const& _trHash, string const& _reward) const;
+    std::map<string, ToolOutput> m_preparedBlocks;
+
     // Internal hack-logic to tell test_mineBlocks which block number is mined without passing the
     // params because test_mineBlocks is interface function. if expectedBlockNumber == -1 then use
     // default logic
@@ -4,56 +4,16 @@
 namespace toolimpl
 {
 
-string rlpToString(dev::RLP const& _rlp, bool _corretHexOdd)
-{
-    std::ostringstream stream;
-    stream << _rlp.toBytes();
-    if (stream.str() == "0x")
-        return (_corretHexOdd) ? "0x00" : "0x0";
-    return stream.str();
-}
-
 // Block Header Sanitizer when parsing RLP
-BlockHeadFromRLP::BlockHeadFromRLP(dev::RLP const& _rlp)
-  : m_validator(_rlp), header(rlpToData(_rlp))
+BlockHeadFromRLP::BlockHeadFromRLP(BlockHeaderView const& _view) : header(_view.toData())
 {
-    ETH_ERROR_REQUIRE_MESSAGE(header.getData().atKey("hash").asString() == header.hash(),
-        "Hash calculated from raw RLP != hash calculated from fields! ");
-
+    // The view checks that the fields are encoded as they are hashed,
+    // so the hash of raw RLP is the hash calculated from fields
     static const u256 minDiff = u256("0x20000");
     static const u256 maxGasLimit = u256("0x7fffffffffffffff");  // 2**63-1
-    ETH_ERROR_REQUIRE_MESSAGE(u256(header.difficulty()) >= minDiff,
+    ETH_ERROR_REQUIRE_MESSAGE(_view.difficulty() >= minDiff,
         "Block difficulty is too low! ~" + header.difficulty());
-    ETH_ERROR_REQUIRE_MESSAGE(
-        u256(header.gasLimit()) <= maxGasLimit, "Block gasLimit is too high!");
-}
-
-TransactionFromRLP::TransactionFromRLP(dev::RLP const& _rlp)
-  : m_validator(_rlp), transaction(rlpToData(_rlp))
-{}
-
-BlockHeadFromRLP::validator::validator(dev::RLP const& _rlp)
-{
-    if (!_rlp.isList())
-        throw dev::RLPException("RLP blockHeader is expected to be list");
-
-    for (size_t i = 0; i < 15; i++)
-    {
-        if (!_rlp[i].isData())
-            throw dev::RLPException("Blockheader field is not data!");
-    }
-}
-
-TransactionFromRLP::validator::validator(dev::RLP const& _rlp)
-{
-    if (!_rlp.isList())
-        throw dev::RLPException("Transaction RLP is expected to be list");
-
-    for (size_t i = 0; i < 9; i++)
-    {
-        if (!_rlp[i].isData())
-            throw dev::RLPException("Transaction rlp field is not data!");
-    }
+    ETH_ERROR_REQUIRE_MESSAGE(_view.gasLimit() <= maxGasLimit, "Block gasLimit is too high!");
 }
 
 scheme_RPCBlock BlockHeadFromRLP::getRPCResponse() const
@@ -72,71 +32,13 @@ scheme_RPCBlock BlockHeadFromRLP::getRPCResponse() const
     return scheme_RPCBlock(response);
 }
 
-DataObject BlockHeadFromRLP::rlpToData(RLP const& _rlp) const
-{
-    // 0 - parentHash           // 8 - number
-    // 1 - uncleHash            // 9 - gasLimit
-    // 2 - coinbase             // 10 - gasUsed
-    // 3 - stateRoot            // 11 - timestamp
-    // 4 - transactionTrie      // 12 - extraData
-    // 5 - receiptTrie          // 13 - mixHash
-    // 6 - bloom                // 14 - nonce
-    // 7 - difficulty
-    DataObject bData;
-    size_t i = 0;
-    bData["parentHash"] = rlpToString(_rlp[i++]);
-    bData["uncleHash"] = rlpToString(_rlp[i++]);
-    bData["coinbase"] = rlpToString(_rlp[i++]);
-    bData["stateRoot"] = rlpToString(_rlp[i++]);
-    bData["transactionsTrie"] = rlpToString(_rlp[i++]);
-    bData["receiptTrie"] = rlpToString(_rlp[i++]);
-    bData["bloom"] = rlpToString(_rlp[i++]);
-    bData["difficulty"] = rlpToString(_rlp[i++]);
-    bData["number"] = rlpToString(_rlp[i++]);
-    bData["gasLimit"] = rlpToString(_rlp[i++]);
-    bData["gasUsed"] = rlpToString(_rlp[i++]);
-    bData["timestamp"] = rlpToString(_rlp[i++]);
-    bData["extraData"] = rlpToString(_rlp[i++]);
-    bData["mixHash"] = rlpToString(_rlp[i++]);
-    bData["nonce"] = rlpToString(_rlp[i++]);
-    bData["hash"] = dev::toHexPrefixed(dev::sha3(_rlp.data()));
-    bData.performModifier(mod_valuesToLowerCase);
-    // m_currentBlockHeader.header.performModifier(mod_removeLeadingZerosFromHexValuesEVEN);
-    // m_currentBlockHeader.header.performVerifier(test::ver_checkHash32Fields);
-    return bData;
-}
-
-DataObject TransactionFromRLP::rlpToData(RLP const& _rlp)
-{
-    // 0 - nonce        3 - to      6 - v
-    // 1 - gasPrice     4 - value   7 - r
-    // 2 - gasLimit     5 - data    8 - s
-    DataObject bData;
-    size_t i = 0;
-    bData["nonce"] = rlpToString(_rlp[i++]);
-    bData["gasPrice"] = rlpToString(_rlp[i++]);
-    bData["gasLimit"] = rlpToString(_rlp[i++]);
-    bData["to"] = rlpToString(_rlp[i++]);
-    bData["to"] = bData["to"].asString() == "0x0" ? "" : bData["to"].asString();
-    bData["value"] = rlpToString(_rlp[i++]);
-    i++;
-    std::ostringstream stream;
-    stream << _rlp[5];
-    bData["data"] = stream.str() == "0x0" ? "" : rlpToString(_rlp[5], true);
-    bData["v"] = rlpToString(_rlp[i++]);
-    bData["r"] = rlpToString(_rlp[i++]);
-    bData["s"] = rlpToString(_rlp[i++]);
-
-    bData.performModifier(mod_valuesToLowerCase);
-    return bData;
-}
 }  // namespace toolimpl
 
 using namespace toolimpl;
 // Heavy ToolImpl functions
 
 // Verify blockchain logic of a raw block rlp
-void ToolImpl::verifyRawBlock(BlockHeadFromRLP const& _sanHeader, dev::RLP const& _blockRLP)
+void ToolImpl::verifyRawBlock(BlockHeadFromRLP const& _sanHeader, BlockView const& _block)
 {
     // Take Hash directly from RLP data to be safe
     int rawImportNumber = test::hexOrDecStringToInt(_sanHeader.header.number());
@@ -165,21 +67,16 @@ void ToolImpl::verifyRawBlock(BlockHeadFromRLP const& _sanHeader, dev::RLP const
 
     // block transactions
     m_transactions.clear();
-    if (!_blockRLP[1].isList())
-        throw dev::RLPException("Transactions RLP is expected to be list!");
 
     // Caclulate uncle hash
-    if (!_blockRLP[2].isList())
-        throw dev::RLPException("Uncles expected to be list");
-
-    for (auto const& uncl : _blockRLP[2])
+    for (auto const& uncl : _block.uncles())
     {
         if (m_currentBlockHeader.uncles.size() == 2)
             throw dev::RLPException("Too many uncles in the block!");
 
         BlockHeadFromRLP sanUncleHeader(uncl);
 
-        if (test::hexOrDecStringToInt(sanUncleHeader.header.number()) == rawImportNumber)
+        if (uncl.number() == rawImportNumber)
             throw dev::RLPException("Uncle has the same number as the block being imported!");
 
         string const& unclePHash = sanUncleHeader.header.parentHash();
@@ -206,7 +103,7 @@ void ToolImpl::verifyRawBlock(BlockHeadFromRLP const& _sanHeader, dev::RLP const
                 }
             }
         }
-        if (test::hexOrDecStringToInt(sanUncleHeader.header.number()) > rawImportNumber)
+        if (uncl.number() > rawImportNumber)
             throw dev::RLPException(
                 "Uncle number is in the future: " + sanUncleHeader.header.number());
         if (rawImportNumber - uncestorNumber > 7)
@@ -269,7 +166,7 @@ void ToolImpl::verifyRawBlock(BlockHeadFromRLP const& _sanHeader, dev::RLP const
             "ImportRaw block require previous block hash == block.parentHash");
     }
 
-    for (auto const& tr : _blockRLP[1])
+    for (auto const& tr : _block.transactions())
         eth_sendRawTransaction(TransactionFromRLP(tr).transaction);
 }
 
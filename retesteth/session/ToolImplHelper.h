@@ -1,50 +1,27 @@
 #pragma once
-#include <libdevcore/RLP.h>
 #include <retesteth/dataObject/DataObject.h>
 #include <retesteth/ethObjects/common.h>
+#include <retesteth/session/BlockRLPView.h>
 #include <string>
 
 using namespace dataobject;
 namespace toolimpl
 {
-// Reading dev::RLP into string
-std::string rlpToString(dev::RLP const&, bool _corretHexOdd = false);
-
-// Sanitize ethereum structures / objects from RLP
+// Sanitize ethereum structures / objects from validated RLP views
 class BlockHeadFromRLP
 {
 public:
-    BlockHeadFromRLP(dev::RLP const&);
+    BlockHeadFromRLP(BlockHeaderView const&);
     scheme_RPCBlock getRPCResponse() const;
 
-private:
-    class validator
-    {
-    public:
-        validator(dev::RLP const&);
-    };
-    validator m_validator;
-    DataObject rlpToData(dev::RLP const&) const;
-
-public:
     scheme_blockHeader header;
 };
 
 class TransactionFromRLP
 {
 public:
-    TransactionFromRLP(dev::RLP const&);
+    TransactionFromRLP(TransactionView const& _view) : transaction(_view.toData()) {}
 
-private:
-    class validator
-    {
-    public:
-        validator(dev::RLP const&);
-    };
-    validator m_validator;
-    DataObject rlpToData(dev::RLP const&);
-
-public:
     scheme_transaction transaction;
 };
 
@@ -1,6 +1,7 @@
 #include "Common.h"
 #include <dataObject/DataObject.h>
 #include <retesteth/Options.h>
+#include <retesteth/TestTrace.h>
 #include <retesteth/session/RPCSession.h>
 using namespace std;
 namespace test
@@ -11,12 +12,39 @@ void validatePostHash(
     string actualHash = _latestInfo.getStateHash();
     if (actualHash != _postHash)
     {
-        if (Options::get().logVerbosity >= 5)
-            ETH_LOG("\nState Dump: \n" + getRemoteState(_session, _latestInfo).getData().asJson(), 5);
+        ETH_LOG("\nState Dump: \n" + getRemoteState(_session, _latestInfo).getData().asJson(), 5);
         ETH_ERROR_MESSAGE("Post hash mismatch remote: " + actualHash + ", expected: " + _postHash);
     }
 }
 
+void validatePostState(
+    SessionInterface& _session, scheme_state const& _post, scheme_RPCBlock const& _latestInfo)
+{
+    if (_post.isHash())
+    {
+        validatePostHash(_session, _post.getHash(), _latestInfo);
+        return;
+    }
+
+    // The post state of a filled test is complete, so its root is the expected state root
+    dev::h256 expectedRoot;
+    {
+        PhaseTimer timer(TestPhase::Compare);
+        expectedRoot = _post.stateRoot();
+    }
+    string const& actualHash = _latestInfo.getStateHash();
+    if (dev::h256(actualHash) == expectedRoot)
+        return;
+
+    // Read the accounts from the client only to report what is different
+    // The roots differ even if the accounts compare equal (e.g. an account missing in the test)
+    string const message = "Post state root mismatch remote: " + actualHash +
+                           ", computed from test: 0x" + toString(expectedRoot);
+    ETH_LOG(message + ". Comparing accounts", 5);
+    compareStates(scheme_expectState(_post.getData()), _session, _latestInfo);
+    ETH_ERROR_MESSAGE(message);
+}
+
 void checkDataObject(DataObject const& _input)
 {
     ETH_ERROR_REQUIRE_MESSAGE(_input.type() == DataType::Object,
@@ -57,9 +85,23 @@ void checkTestNameIsEqualToFileName(DataObject const& _input)
                 "'");
 }
 
+const int RangePageSize::c_minSize;
+const int RangePageSize::c_maxSize;
+
+void RangePageSize::update(size_t _received, std::chrono::steady_clock::duration _latency)
+{
+    // a reply within the target latency is cheap compared to the round trip itself
+    std::chrono::milliseconds const c_targetLatency(200);
+    if (_latency > 2 * c_targetLatency)
+        m_size = std::max(c_minSize, m_size / 2);
+    else if (_received >= (size_t)m_size && _latency < c_targetLatency)
+        m_size = std::min(c_maxSize, m_size * 2);
+}
+
 scheme_account remoteGetAccount(SessionInterface& _session, string const& _account,
     scheme_RPCBlock const& _latestInfo, size_t& _totalSize)
 {
+    PhaseTimer timer(TestPhase::StateFetch);
     DataObject accountObj;
     accountObj.setKey(_account);
     accountObj["code"] = _session.eth_getCode(_account, _latestInfo.getNumber());
@@ -69,32 +111,33 @@ scheme_account remoteGetAccount(SessionInterface& _session, string const& _accou
     accountObj["balance"] = _session.eth_getBalance(_account, _latestInfo.getNumber());
 
     // Storage
-    const size_t cycles_max = 100;
-    const int cmaxRows = 100;
     DataObject storage(DataType::Object);
+    RangePageSize pageSize;
     string beginHash = "0";
-    size_t cycles = cycles_max;
-    while (--cycles)
+    while (true)
     {
+        auto const start = std::chrono::steady_clock::now();
         DataObject debugStorageAt = _session.debug_storageRangeAt(_latestInfo.getNumber(),
-            _latestInfo.getTransactionCount(), _account, beginHash, cmaxRows);
+            _latestInfo.getTransactionCount(), _account, beginHash, pageSize.get());
         auto const& subObjects = debugStorageAt["storage"].getSubObjects();
+        pageSize.update(subObjects.size(), std::chrono::steady_clock::now() - start);
         _totalSize += subObjects.size() * 64;
         for (auto const& element : subObjects)
             storage[element.atKey("key").asString()] = element.atKey("value").asString();
-        if (debugStorageAt.count("nextKey"))
-            beginHash = debugStorageAt.atKey("nextKey").asString();
-        else
+        if (!debugStorageAt.count("nextKey"))
             break;
+        string const& nextKey = debugStorageAt.atKey("nextKey").asString();
+        ETH_ERROR_REQUIRE_MESSAGE(nextKey != beginHash,
+            "debug_storageRangeAt returned the requested key as nextKey: " + nextKey);
+        beginHash = nextKey;
     }
     accountObj["storage"] = storage;
-    ETH_ERROR_REQUIRE_MESSAGE(cycles > 0,
-        "Remote state has too many storage records! (" + to_string(cycles_max * cmaxRows) + ")");
     return scheme_account(accountObj);
 }
 
 scheme_state getRemoteState(SessionInterface& _session, scheme_RPCBlock const& _latestInfo)
 {
+    // Requests to the client are timed as StateFetch by the helpers
     const int c_accountLimitBeforeHash = 20;
     DataObject accountsObj;
 
@@ -103,6 +146,7 @@ scheme_state getRemoteState(SessionInterface& _session, scheme_RPCBlock const& _
     DataObject accountList;
     if (!Options::get().fullstate)
     {
+        PhaseTimer timer(TestPhase::StateFetch);
         scheme_debugAccountRange res = _session.debug_accountRange(_latestInfo.getNumber(),
             _latestInfo.getTransactionCount(), "", c_accountLimitBeforeHash);
 
@@ -19,8 +19,12 @@ along with cpp-ethereum.  If not, see <http://www.gnu.org/licenses/>.
  */
 
 #pragma once
+#include <retesteth/ethObjects/stateTest/NativeState.h>
 #include <retesteth/session/RPCSession.h>
 #include <boost/filesystem/path.hpp>
+#include <chrono>
+#include <functional>
+#include <unordered_set>
 
 namespace test
 {
@@ -29,6 +33,11 @@ namespace test
 void validatePostHash(
     SessionInterface& _session, string const& _postHash, scheme_RPCBlock const& _latestInfo);
 
+// Check post state by the state root of the latest block. Account details are requested from
+// the client only if the root computed from _post is different
+void validatePostState(
+    SessionInterface& _session, scheme_state const& _post, scheme_RPCBlock const& _latestInfo);
+
 // Get Remote State From Client
 scheme_state getRemoteState(SessionInterface& _session, scheme_RPCBlock const& _latestInfo);
 
@@ -44,12 +53,52 @@ void checkAtLeastOneTest(DataObject const& _input);
 // Check test name in the file is equal to the test name of the file
 void checkTestNameIsEqualToFileName(DataObject const& _input);
 
-// Compare states with session asking post state data on the fly
+// Compare states with session asking post state data on the fly. With --fullstate every account
+// of the post state is read (and printed with --poststate), otherwise only expected accounts
 void compareStates(scheme_expectState const& _stateExpect, SessionInterface& _session,
     scheme_RPCBlock const& _latestInfo);
 void compareStates(scheme_expectState const& _stateExpect, scheme_state const& _statePost);
+
+// Compare post state accounts with the expect section one at a time as they are read.
+// The accounts are not kept, only the expect section and the compare result
+class StateComparator
+{
+public:
+    StateComparator(scheme_expectState const& _stateExpect);
+    StateComparator(StateComparator const&) = delete;
+
+    // Only the accounts of expect section have to be read from the post state
+    bool isExpected(dev::Address const& _address) const { return m_expectByAddress.count(_address); }
+    // Check the post state account. Returns false when the rest of post state is not needed
+    bool compare(dev::Address const& _address, NativeAccount const& _account);
+    // Check the expect section accounts that were not in post state, throws on errors
+    void finish();
+
+private:
+    std::vector<NativeExpectAccount> m_expect;
+    std::unordered_map<dev::Address, NativeExpectAccount const*> m_expectByAddress;
+    std::unordered_set<dev::Address> m_found;
+    bool m_hasShouldNotExist = false;
+    CompareResult m_result = CompareResult::Success;
+};
 string CompareResultToString(CompareResult res);
 
+// Page size of debug_accountRange / debug_storageRangeAt requests. Grows while the client
+// returns full pages fast, shrinks when a reply is slow
+class RangePageSize
+{
+public:
+    RangePageSize(int _initial = 100) : m_size(_initial) {}
+    int get() const { return m_size; }
+    void update(size_t _received, std::chrono::steady_clock::duration _latency);
+
+    static const int c_minSize = 10;
+    static const int c_maxSize = 10000;
+
+private:
+    int m_size;
+};
+
 // Get account from remote state. inline function
 scheme_account remoteGetAccount(SessionInterface& _session, string const& _account,
     scheme_RPCBlock const& _latestInfo, size_t& _totalSize);
@@ -57,6 +106,11 @@ scheme_account remoteGetAccount(SessionInterface& _session, string const& _accou
 // Get list of account from remote client
 DataObject getRemoteAccountList(SessionInterface& _session, scheme_RPCBlock const& _latestInfo);
 
+// Read the account list of remote client page by page. _onAccount is called with each address
+// as soon as its page is received and returns false to stop reading
+void forEachRemoteAccount(SessionInterface& _session, scheme_RPCBlock const& _latestInfo,
+    std::function<bool(string const&)> const& _onAccount);
+
 // json trace vm
 void printVmTrace(SessionInterface& _session, std::string const& _trHash, string const& _stateRoot);
 }
@@ -1,35 +1,55 @@
 #include "Common.h"
 #include <dataObject/DataObject.h>
 #include <retesteth/Options.h>
+#include <retesteth/TestTrace.h>
+#include <retesteth/ethObjects/stateTest/NativeState.h>
 #include <retesteth/session/RPCSession.h>
+#include <unordered_set>
 using namespace std;
 namespace test
 {
 // inline function, because _actualExistance could be asked via remote RPC request
-CompareResult checkExistance(scheme_expectAccount const& _expectAccount, bool _actualExistance)
+CompareResult checkExistance(NativeExpectAccount const& _expectAccount, bool _actualExistance)
 {
     // if should not exist but actually exists
-    if (_expectAccount.shouldNotExist() && _actualExistance)
+    if (_expectAccount.shouldNotExist && _actualExistance)
     {
-        ETH_MARK_ERROR(
-            "Compare States: '" + _expectAccount.address() + "' address not expected to exist!");
+        ETH_MARK_ERROR("Compare States: '" + _expectAccount.addressString +
+                       "' address not expected to exist!");
         return CompareResult::AccountShouldNotExist;
     }
     // if expected to exist but actually not exists
-    if (!_expectAccount.shouldNotExist() && !_actualExistance)
+    if (!_expectAccount.shouldNotExist && !_actualExistance)
     {
         ETH_MARK_ERROR(
-            "Compare States: Missing expected address: '" + _expectAccount.address() + "'");
+            "Compare States: Missing expected address: '" + _expectAccount.addressString + "'");
         return CompareResult::MissingExpectedAccount;
     }
     return CompareResult::Success;
 }
 
-// inline function
-CompareResult compareAccounts(
-    scheme_account const& _inState, scheme_expectAccount const& _expectAccount)
+vector<NativeExpectAccount> makeNativeExpectAccounts(scheme_expectState const& _stateExpect)
+{
+    vector<NativeExpectAccount> accounts;
+    accounts.reserve(_stateExpect.getAccounts().size());
+    for (auto const& a : _stateExpect.getAccounts())
+        accounts.push_back(NativeExpectAccount(a));
+    return accounts;
+}
+
+string hexValue(u256 const& _value)
+{
+    return dev::toCompactHexPrefixed(_value, 1);
+}
+
+string hexStorageKey(h256 const& _key)
+{
+    return dev::toCompactHexPrefixed(u256(_key), 1);
+}
+
+// Check that post storage has values from expected storage
+CompareResult compareStorage(NativeStorage const& _storage, NativeExpectAccount const& _expect)
 {
-    // report all errors, but return the last error as a compare result
     CompareResult result = CompareResult::Success;
     auto checkMessage = [&result](bool _flag, CompareResult _type, string const& _error) -> void {
         ETH_MARK_ERROR_FLAG(_flag, _error);
@@ -37,127 +57,230 @@ CompareResult compareAccounts(
             result = _type;
     };
 
-    if (_expectAccount.hasBalance())
+    string const message = "Check State: Remote account '" + _expect.addressString + "'";
+    for (auto const& element : _expect.storage)
     {
-        u256 inStateB = u256(_inState.getData().atKey("balance").asString());
-        checkMessage(_expectAccount.getData().atKey("balance").asString() ==
-                         _inState.getData().atKey("balance").asString(),
-            CompareResult::IncorrectBalance,
-            "Check State: Remote account '" +
-                _expectAccount.address() + "': has incorrect balance " + toString(inStateB) +
-                ", test expected " +
-                toString(u256(_expectAccount.getData().atKey("balance").asString())) + " (" +
-                _expectAccount.getData().atKey("balance").asString() +
-                " != " + _inState.getData().atKey("balance").asString() + ")");
+        auto const record = _storage.find(element.first);
+        string const key = hexStorageKey(element.first);
+        if (element.second == 0)
+        {
+            // if a post state has the value of 'key' as zero, such 'key' does not listed
+            checkMessage(record == _storage.end(), CompareResult::IncorrectStorage,
+                message + " has storage key '" + key + "' : '" +
+                    (record == _storage.end() ? string() : hexValue(record->second)) +
+                    "'. Test expected storage key: '" + key + "' to be set to zero");
+        }
+        else
+        {
+            checkMessage(record != _storage.end(), CompareResult::IncorrectStorage,
+                message + " test expected storage key: '" + key + "' to be set to: '" +
+                    hexValue(element.second) + "', but remote key '" + key +
+                    "' does not exist!");
+            if (result != CompareResult::Success)
+                return result;
+
+            checkMessage(record->second == element.second, CompareResult::IncorrectStorage,
+                message + ": has incorrect storage [" + key + "] = " + hexValue(record->second) +
+                    ", test expected [" + key + "] = " + hexValue(element.second));
+        }
     }
 
-    if (_expectAccount.hasNonce())
-        checkMessage(_expectAccount.getData().atKey("nonce").asString() ==
-                         _inState.getData().atKey("nonce").asString(),
-            CompareResult::IncorrectNonce,
-            "Check State: Remote account '" +
-                _expectAccount.address() + "': has incorrect nonce " +
-                _inState.getData().atKey("nonce").asString() + ", test expected " +
-                _expectAccount.getData().atKey("nonce").asString());
-
-    // Check that state post has values from expected storage
-    if (_expectAccount.hasStorage())
+    if (_expect.storage.size() < _storage.size())
     {
-        CompareResult res = _expectAccount.compareStorage(_inState.getData().atKey("storage"));
+        ETH_MARK_ERROR(TestOutputHelper::get().testName() + " Remote account '" +
+                       _expect.addressString + "' storage has more storage records than expected!");
+        result = CompareResult::IncorrectStorage;
+
+        std::unordered_map<h256, u256> expectStorage;
+        for (auto const& element : _expect.storage)
+            expectStorage[element.first] = element.second;
+        for (auto const& record : _storage)
+        {
+            auto const expected = expectStorage.find(record.first);
+            string const key = hexStorageKey(record.first);
+            ETH_MARK_ERROR("incorrect remote storage [" + key + "] = " + hexValue(record.second) +
+                           ", test expected [" + key + "] = " +
+                           (expected == expectStorage.end() ? "0" : hexValue(expected->second)));
+        }
+    }
+    return result;
+}
+
+// inline function
+CompareResult compareAccounts(NativeAccount const& _inState, NativeExpectAccount const& _expect)
+{
+    // report all errors, but return the last error as a compare result
+    CompareResult result = CompareResult::Success;
+    auto checkMessage = [&result](bool _flag, CompareResult _type, string const& _error) -> void {
+        ETH_MARK_ERROR_FLAG(_flag, _error);
+        if (!_flag)
+            result = _type;
+    };
+
+    if (_expect.hasBalance)
+        checkMessage(_expect.balance == _inState.balance, CompareResult::IncorrectBalance,
+            "Check State: Remote account '" + _expect.addressString +
+                "': has incorrect balance " + toString(_inState.balance) + ", test expected " +
+                toString(_expect.balance) + " (" + hexValue(_expect.balance) +
+                " != " + hexValue(_inState.balance) + ")");
+
+    if (_expect.hasNonce)
+        checkMessage(_expect.nonce == _inState.nonce, CompareResult::IncorrectNonce,
+            "Check State: Remote account '" + _expect.addressString + "': has incorrect nonce " +
+                hexValue(_inState.nonce) + ", test expected " + hexValue(_expect.nonce));
+
+    if (_expect.hasStorage)
+    {
+        CompareResult res = compareStorage(_inState.storage, _expect);
         if (result == CompareResult::Success)
             result = res;  // Only override success result with potential error
     }
 
-    if (_expectAccount.hasCode())
-        checkMessage(_expectAccount.getData().atKey("code").asString() ==
-                         _inState.getData().atKey("code").asString(),
-            CompareResult::IncorrectCode,
-            "Check State: Remote account '" +
-                _expectAccount.address() + "': has incorrect code '" +
-                _inState.getData().atKey("code").asString() + "', test expected '" +
-                _expectAccount.getData().atKey("code").asString() + "'");
+    if (_expect.hasCode)
+        checkMessage(_expect.code == _inState.code, CompareResult::IncorrectCode,
+            "Check State: Remote account '" + _expect.addressString + "': has incorrect code '" +
+                dev::toHexPrefixed(_inState.code) + "', test expected '" +
+                dev::toHexPrefixed(_expect.code) + "'");
 
     return result;
 }
 
-DataObject getRemoteAccountList(SessionInterface& _session, scheme_RPCBlock const& _latestInfo)
+void forEachRemoteAccount(SessionInterface& _session, scheme_RPCBlock const& _latestInfo,
+    std::function<bool(string const&)> const& _onAccount)
 {
-    DataObject accountList;
+    RangePageSize pageSize;
     string startHash = "0";
-    const int cmaxRows = 100;
-    const size_t cycles_max = 100;
-    size_t cycles = 0;
-    while (cycles++ <= cycles_max)
+    bool firstPage = true;
+    while (true)
     {
-        scheme_debugAccountRange res = _session.debug_accountRange(
-            _latestInfo.getNumber(), _latestInfo.getTransactionCount(), startHash, cmaxRows);
-        auto const& subObjects = res.getAccountMap();
-        for (auto const& element : subObjects.getSubObjects())
-            accountList.addSubObject(element.asString(), DataObject(DataType::Null));
+        PhaseTimer fetchTimer(TestPhase::StateFetch);
+        auto const start = std::chrono::steady_clock::now();
+        scheme_debugAccountRange res = _session.debug_accountRange(_latestInfo.getNumber(),
+            _latestInfo.getTransactionCount(), startHash, pageSize.get());
+        auto const& subObjects = res.getAccountMap().getSubObjects();
+        pageSize.update(subObjects.size(), std::chrono::steady_clock::now() - start);
+        fetchTimer.stop();
+
+        // next page starts from the last account of the previous one
+        size_t newAccounts = 0;
+        for (auto const& element : subObjects)
+        {
+            if (!firstPage && element.getKey() == startHash)
+                continue;
+            newAccounts++;
+            if (!_onAccount(element.asString()))
+                return;
+        }
         if (!res.isNextKey())
             break;
-        if (subObjects.getSubObjects().size() > 0)
-            startHash = subObjects.at(subObjects.getSubObjects().size() - 1).getKey();
+        ETH_ERROR_REQUIRE_MESSAGE(newAccounts > 0,
+            "debug_accountRange returned no new accounts, but has nextKey! Start: " + startHash);
+        startHash = subObjects.at(subObjects.size() - 1).getKey();
+        firstPage = false;
     }
-    ETH_ERROR_REQUIRE_MESSAGE(cycles <= cycles_max,
-        "Remote state has too many accounts! (>" + to_string(cycles_max * cmaxRows) + ")");
+}
+
+DataObject getRemoteAccountList(SessionInterface& _session, scheme_RPCBlock const& _latestInfo)
+{
+    DataObject accountList;
+    forEachRemoteAccount(_session, _latestInfo, [&accountList](string const& _address) {
+        accountList.addSubObject(_address, DataObject(DataType::Null));
+        return true;
+    });
     return accountList;
 }
 
-// compare states with full post information
-// CompareResult compareStates(scheme_expectState const& _stateExpect, scheme_state const&
-// _statePost);  CompareResult compareStates(scheme_state const& _stateExpect, scheme_state const&
-// _statePost)
-//{
-//    return compareStates(scheme_expectState(_stateExpect.getData()), _statePost);
-//}
+StateComparator::StateComparator(scheme_expectState const& _stateExpect)
+  : m_expect(makeNativeExpectAccounts(_stateExpect))
+{
+    for (auto const& a : m_expect)
+    {
+        m_expectByAddress[a.address] = &a;
+        m_hasShouldNotExist = m_hasShouldNotExist || a.shouldNotExist;
+    }
+}
 
-// compare states with session asking post state data on the fly
-void compareStates(scheme_expectState const& _stateExpect, SessionInterface& _session,
-    scheme_RPCBlock const& _latestInfo)
+bool StateComparator::compare(Address const& _address, NativeAccount const& _account)
 {
-    CompareResult result = CompareResult::Success;
-    DataObject accountList = getRemoteAccountList(_session, _latestInfo);
-    for (auto const& a : _stateExpect.getAccounts())
+    auto const expect = m_expectByAddress.find(_address);
+    if (expect != m_expectByAddress.end())
     {
-        bool hasAccount = accountList.count(a.address());
-        CompareResult existanceResult = checkExistance(a, hasAccount);
+        m_found.insert(_address);
+        NativeExpectAccount const& a = *expect->second;
+        CompareResult existanceResult = checkExistance(a, true);
         if (existanceResult != CompareResult::Success)
+            m_result = existanceResult;
+        else
         {
-            result = existanceResult;
-            continue;
+            // Compare account in postState with expect section account
+            CompareResult accountCompareResult = compareAccounts(_account, a);
+            if (accountCompareResult != CompareResult::Success)
+                m_result = accountCompareResult;
         }
-        if (!hasAccount)
+    }
+    // Absence of an account is known only at the end of the state
+    return m_hasShouldNotExist || m_found.size() < m_expectByAddress.size();
+}
+
+void StateComparator::finish()
+{
+    for (auto const& a : m_expect)
+    {
+        if (m_found.count(a.address))
             continue;
+        CompareResult existanceResult = checkExistance(a, false);
+        if (existanceResult != CompareResult::Success)
+            m_result = existanceResult;
+    }
+    if (m_result != CompareResult::Success)
+        ETH_ERROR_MESSAGE("CompareStates failed with errors: " + CompareResultToString(m_result));
+}
 
-        // Compare account in postState with expect section account
+void compareStates(scheme_expectState const& _stateExpect, SessionInterface& _session,
+    scheme_RPCBlock const& _latestInfo)
+{
+    // Remote requests are timed as StateFetch, only the comparison as Compare
+    bool const fullState = Options::get().fullstate;
+    bool const printState = Options::get().poststate;
+    if (printState)
+        ETH_STDOUT_MESSAGE("PostState " + TestOutputHelper::get().testInfo().errorDebug() + " : ");
+
+    // Accounts are compared while the account list is read and are not kept
+    StateComparator comparator(_stateExpect);
+    forEachRemoteAccount(_session, _latestInfo, [&](string const& _address) {
+        Address const address(_address);
+        if (!fullState && !comparator.isExpected(address))
+            return true;
         size_t totalSize = 0;
-        CompareResult accountCompareResult =
-            compareAccounts(remoteGetAccount(_session, a.address(), _latestInfo, totalSize), a);
-        if (accountCompareResult != CompareResult::Success)
-            result = accountCompareResult;
-    }
-    if (result != CompareResult::Success)
-        ETH_ERROR_MESSAGE("CompareStates failed with errors: " + CompareResultToString(result));
+        scheme_account const remote = remoteGetAccount(_session, _address, _latestInfo, totalSize);
+        if (printState)
+            ETH_STDOUT_MESSAGE(remote.getData().asJson());
+        PhaseTimer timer(TestPhase::Compare);
+        return comparator.compare(address, NativeState::makeAccount(remote)) || fullState;
+    });
+    PhaseTimer timer(TestPhase::Compare);
+    comparator.finish();
 }
 
 void compareStates(scheme_expectState const& _stateExpect, scheme_state const& _statePost)
 {
+    PhaseTimer timer(TestPhase::Compare);
     CompareResult result = CompareResult::Success;
-    for (auto const& a : _stateExpect.getAccounts())
+    NativeState const post(_statePost);
+    for (auto const& a : makeNativeExpectAccounts(_stateExpect))
     {
-        bool hasAccount = _statePost.hasAccount(a.address());
-        CompareResult existanceResult = checkExistance(a, hasAccount);
+        NativeAccount const* account = post.getAccount(a.address);
+        CompareResult existanceResult = checkExistance(a, account != nullptr);
         if (existanceResult != CompareResult::Success)
         {
             result = existanceResult;
             continue;
         }
-        if (!hasAccount)
+        if (!account)
             continue;
 
         // Compare account in postState with expect section account
-        CompareResult accountCompareResult = compareAccounts(_statePost.getAccount(a.address()), a);
+        CompareResult accountCompareResult = compareAccounts(*account, a);
         if (accountCompareResult != CompareResult::Success)
             result = accountCompareResult;
     }
@@ -23,6 +23,8 @@
 
 #include <boost/filesystem/operations.hpp>
 #include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <functional>
 #include <thread>
 #include <mutex>
 
@@ -34,6 +36,8 @@
 #include <retesteth/TestHelper.h>
 #include <retesteth/TestOutputHelper.h>
 #include <retesteth/TestSuite.h>
+#include <retesteth/TestTrace.h>
+#include <retesteth/WorkerPool.h>
 #include <retesteth/ethObjects/common.h>
 #include <retesteth/session/RPCSession.h>
 #include <retesteth/testSuites/Common.h>
@@ -56,6 +60,43 @@ bool OptionsAllowTransaction(scheme_generalTransaction::transactionInfo const& _
     return false;
 }
 
+/// Let the session calculate all transactions of the test that are going to be executed on the
+/// current chain params in parallel (--t8nbatch)
+void prepareTransactions(SessionInterface& _session, testprivate::scheme_stateTestBase const& _test,
+    std::function<bool(scheme_generalTransaction::transactionInfo const&)> const& _isExecuted)
+{
+    if (Options::get().t8nbatch == 0)
+        return;
+
+    std::vector<scheme_transaction> transactions;
+    for (auto const& tr : _test.getTransactions())
+        if (OptionsAllowTransaction(tr) && _isExecuted(tr))
+            transactions.push_back(tr.transaction);
+    u256 a(_test.getEnv().getData().atKey("currentTimestamp").asString());
+    _session.test_prepareSingleTransactionBlocks(transactions, a.convert_to<size_t>());
+}
+
+/// Sign the transactions of the test at once before they are sent on every network
+void signTransactions(testprivate::scheme_stateTestBase const& _test)
+{
+    std::vector<scheme_transaction const*> transactions;
+    for (auto const& tr : _test.getTransactions())
+        if (OptionsAllowTransaction(tr))
+            transactions.push_back(&tr.transaction);
+    scheme_transaction::signAll(transactions);
+}
+
+/// Transaction is executed on _net if there is an expect section for it
+bool hasExpectSection(test::scheme_stateTestFiller const& _test, string const& _net,
+    scheme_generalTransaction::transactionInfo const& _tr)
+{
+    for (auto const& expect : _test.getExpectSection().getExpectSections())
+        if (expect.getNetworks().count(_net) &&
+            expect.checkIndexes(_tr.dataInd, _tr.gasInd, _tr.valueInd))
+            return true;
+    return false;
+}
+
 /// Generate a blockchain test from state test filler
 DataObject FillTestAsBlockchain(DataObject const& _testFile)
 {
@@ -66,6 +107,16 @@ DataObject FillTestAsBlockchain(DataObject const& _testFile)
     // run transactions on all networks that we need
     for (auto const& net : test.getExpectSection().getAllNetworksFromExpectSection())
     {
+        if (Options::get().t8nbatch)
+        {
+            session.test_setChainParams(
+                test.getGenesisForRPC(net, scheme_blockchainTestBase::m_sNoProof));
+            prepareTransactions(
+                session, test, [&test, &net](scheme_generalTransaction::transactionInfo const& _tr) {
+                    return hasExpectSection(test, net, _tr);
+                });
+        }
+
         // run transactions for defined expect sections only
         for (auto const& expect : test.getExpectSection().getExpectSections())
         {
@@ -161,6 +212,122 @@ DataObject FillTestAsBlockchain(DataObject const& _testFile)
     return filledTest;
 }
 
+/// One transaction of the state test executed on one network. With -j the transactions of a
+/// test are executed as separate units on all sessions of the worker pool
+struct TransactionUnit
+{
+    TransactionUnit(string const& _network, size_t _sectionInd, size_t _trInd)
+      : network(_network), sectionInd(_sectionInd), trInd(_trInd)
+    {}
+    string network;
+    size_t sectionInd;  // expect section (filling) or post result (running) of the transaction
+    size_t trInd;       // index in getTransactions()
+    DataObject output;
+};
+
+/// Execute state test transactions as units when the test is run by a pool with many workers
+/// --t8nbatch prepares all transactions of a network on one session instead
+bool executeAsUnits()
+{
+    WorkerPool const* pool = WorkerPool::current();
+    return pool && pool->threadCount() > 1 && Options::get().t8nbatch == 0;
+}
+
+/// Units group and network which chain params are set on the session of this thread
+struct UnitChainParams
+{
+    size_t group = 0;
+    string network;
+};
+thread_local UnitChainParams t_unitChainParams;
+std::atomic<size_t> g_unitGroups(0);
+
+/// Execute units on the current thread and idle workers of the pool. A thread executes units
+/// of the group one after another, so chain params are set on its session only when the network
+/// changes (transactions rewind the chain to genesis). Errors are stored in the output
+/// helper of that thread, so here only mark the whole test as failed
+void executeUnits(testprivate::scheme_stateTestBase const& _test,
+    std::vector<TransactionUnit>& _units,
+    std::function<void(SessionInterface&, TransactionUnit&)> const& _execute)
+{
+    fs::path const testFile = TestOutputHelper::get().testFile();
+    string const testName = TestOutputHelper::get().testName();
+    size_t const group = ++g_unitGroups;
+    std::atomic<bool> wereErrors(false);
+    std::vector<std::function<void()>> tasks;
+    for (auto& unit : _units)
+        tasks.push_back([&_test, &unit, &_execute, &wereErrors, testFile, testName, group]() {
+            if (ExitHandler::receivedExitSignal())
+                return;
+            TestOutputHelper& output = TestOutputHelper::get();
+            output.setCurrentTestFile(testFile);
+            output.setCurrentTestName(testName);
+            auto const& tr = _test.getTransactions().at(unit.trInd);
+            output.setCurrentTestInfo(TestInfo(unit.network, tr.dataInd, tr.gasInd, tr.valueInd));
+            size_t const errorsBefore = output.errorCount();
+            SessionInterface& session = RPCSession::instance(TestOutputHelper::getThreadID());
+            try
+            {
+                if (t_unitChainParams.group != group || t_unitChainParams.network != unit.network)
+                {
+                    t_unitChainParams = UnitChainParams();
+                    session.test_setChainParams(_test.getGenesisForRPC(unit.network, "NoReward"));
+                    t_unitChainParams.group = group;
+                    t_unitChainParams.network = unit.network;
+                }
+                _execute(session, unit);
+                // errors marked without exception are stored at the worker helper
+                if (output.errorCount() != errorsBefore)
+                    wereErrors = true;
+            }
+            catch (test::BaseEthException const&)
+            {
+                // the chain of the failed transaction is not rewound
+                t_unitChainParams = UnitChainParams();
+                wereErrors = true;
+            }
+        });
+    WorkerPool::current()->runTaskGroup(tasks);
+    if (wereErrors)
+        throw EthError() << "State test transaction failed";
+}
+
+/// Execute the transaction on the session with chain params of the network. Returns post results
+DataObject FillTransaction(SessionInterface& _session, test::scheme_stateTestFiller const& _test,
+    scheme_expectSectionElement const& _expect, scheme_generalTransaction::transactionInfo const& _tr)
+{
+    u256 a(_test.getEnv().getData().atKey("currentTimestamp").asString());
+    _session.test_modifyTimestamp(a.convert_to<size_t>());
+    string trHash = _session.eth_sendRawTransaction(_tr.transaction);
+    string latestBlockNumber = _session.test_mineBlocks(1);
+
+    scheme_RPCBlock blockInfo =
+        _session.eth_getBlockByNumber(latestBlockNumber, Options::get().vmtrace);
+    if (Options::get().poststate)
+        ETH_STDOUT_MESSAGE("PostState " + TestOutputHelper::get().testInfo().errorDebug() +
+                           " : \n" + blockInfo.getStateHash());
+    if (Options::get().vmtrace)
+        printVmTrace(_session, trHash, blockInfo.getStateHash());
+    compareStates(_expect.getExpectState(), _session, blockInfo);
+
+    DataObject indexes;
+    DataObject transactionResults;
+    indexes["data"] = _tr.dataInd;
+    indexes["gas"] = _tr.gasInd;
+    indexes["value"] = _tr.valueInd;
+
+    transactionResults["indexes"] = indexes;
+    transactionResults["hash"] = blockInfo.getStateHash();
+
+    // Fill up the loghash (optional)
+    string logHash = _session.test_getLogHash(trHash);
+    if (!logHash.empty())
+        transactionResults["logs"] = logHash;
+
+    _session.test_rewindToBlock(0);
+    return transactionResults;
+}
+
 /// Rewrite the test file. Fill General State Test
 DataObject FillTest(DataObject const& _testFile)
 {
@@ -175,21 +342,35 @@ DataObject FillTest(DataObject const& _testFile)
     filledTest["pre"] = test.getPre().getData();
     filledTest["transaction"] = test.getGenTransaction().getData();
 
+    bool const asUnits = executeAsUnits();
+    std::vector<TransactionUnit> units;
+    auto const& expectSections = test.getExpectSection().getExpectSections();
+    signTransactions(test);
+
     // run transactions on all networks that we need
     for (auto const& net : test.getExpectSection().getAllNetworksFromExpectSection())
     {
         DataObject forkResults;
         forkResults.setKey(net);
-        session.test_setChainParams(test.getGenesisForRPC(net, "NoReward"));
+        if (!asUnits)
+        {
+            session.test_setChainParams(test.getGenesisForRPC(net, "NoReward"));
+            prepareTransactions(
+                session, test, [&test, &net](scheme_generalTransaction::transactionInfo const& _tr) {
+                    return hasExpectSection(test, net, _tr);
+                });
+        }
 
         // run transactions for defined expect sections only
-        for (auto const& expect : test.getExpectSection().getExpectSections())
+        for (size_t expectInd = 0; expectInd < expectSections.size(); expectInd++)
         {
+            auto const& expect = expectSections.at(expectInd);
             // if expect section for this networks
             if (expect.getNetworks().count(net))
             {
-                for (auto& tr : test.getTransactionsUnsafe())
+                for (size_t trInd = 0; trInd < test.getTransactions().size(); trInd++)
                 {
+                    auto& tr = test.getTransactionsUnsafe().at(trInd);
                     TestInfo errorInfo (net, tr.dataInd, tr.gasInd, tr.valueInd);
                     TestOutputHelper::get().setCurrentTestInfo(errorInfo);
 
@@ -203,58 +384,90 @@ DataObject FillTest(DataObject const& _testFile)
                     if (!expect.checkIndexes(tr.dataInd, tr.gasInd, tr.valueInd))
                         continue;
 
-                    u256 a(test.getEnv().getData().atKey("currentTimestamp").asString());
-                    session.test_modifyTimestamp(a.convert_to<size_t>());
-                    string trHash = session.eth_sendRawTransaction(tr.transaction);
-                    string latestBlockNumber = session.test_mineBlocks(1);
-                    tr.executed = true;
-
-                    scheme_RPCBlock blockInfo =
-                        session.eth_getBlockByNumber(latestBlockNumber, Options::get().vmtrace);
-                    if (Options::get().poststate)
-                        ETH_STDOUT_MESSAGE("PostState " +
-                                           TestOutputHelper::get().testInfo().errorDebug() +
-                                           " : \n" + blockInfo.getStateHash());
-                    if (Options::get().vmtrace)
-                        printVmTrace(session, trHash, blockInfo.getStateHash());
-                    if (Options::get().fullstate)
+                    if (asUnits)
                     {
-                        scheme_state remoteState = getRemoteState(session, blockInfo);
-                        compareStates(expect.getExpectState(), remoteState);
+                        units.push_back(TransactionUnit(net, expectInd, trInd));
+                        continue;
                     }
-                    else
-                        compareStates(expect.getExpectState(), session, blockInfo);
-
-                    DataObject indexes;
-                    DataObject transactionResults;
-                    indexes["data"] = tr.dataInd;
-                    indexes["gas"] = tr.gasInd;
-                    indexes["value"] = tr.valueInd;
-
-                    transactionResults["indexes"] = indexes;
-                    transactionResults["hash"] = blockInfo.getStateHash();
-
-                    // Fill up the loghash (optional)
-                    string logHash = session.test_getLogHash(trHash);
-                    if (!logHash.empty())
-                        transactionResults["logs"] = logHash;
 
-                    forkResults.addArrayObject(transactionResults);
-                    session.test_rewindToBlock(0);
+                    tr.executed = true;
+                    forkResults.addArrayObject(FillTransaction(session, test, expect, tr));
                 }
             }
         }
-        test.checkUnexecutedTransactions();
-        filledTest["post"].addSubObject(forkResults);
+        if (!asUnits)
+        {
+            test.checkUnexecutedTransactions();
+            filledTest["post"].addSubObject(forkResults);
+        }
+    }
+
+    if (asUnits)
+    {
+        executeUnits(test, units, [&test](SessionInterface& _session, TransactionUnit& _unit) {
+            _unit.output = FillTransaction(_session, test,
+                test.getExpectSection().getExpectSections().at(_unit.sectionInd),
+                test.getTransactions().at(_unit.trInd));
+        });
+
+        // Units are in the order of sequential execution
+        for (auto const& net : test.getExpectSection().getAllNetworksFromExpectSection())
+        {
+            DataObject forkResults;
+            forkResults.setKey(net);
+            for (auto const& unit : units)
+            {
+                if (unit.network != net)
+                    continue;
+                test.getTransactionsUnsafe().at(unit.trInd).executed = true;
+                forkResults.addArrayObject(unit.output);
+            }
+            test.checkUnexecutedTransactions();
+            filledTest["post"].addSubObject(forkResults);
+        }
     }
     return filledTest;
 }
 
+/// Execute the transaction on the session with chain params of the network and validate results
+void RunTransaction(SessionInterface& _session, test::scheme_stateTest const& _test,
+    string const& _network, scheme_postSectionElement const& _result,
+    scheme_generalTransaction::transactionInfo const& _tr)
+{
+    u256 a(_test.getEnv().getData().atKey("currentTimestamp").asString());
+    _session.test_modifyTimestamp(a.convert_to<size_t>());
+    string trHash = _session.eth_sendRawTransaction(_tr.transaction);
+    string latestBlockNumber = _session.test_mineBlocks(1);
+
+    // Validate post state
+    string postHash = _result.getData().atKey("hash").asString();
+    scheme_RPCBlock remoteBlockInfo = _session.eth_getBlockByNumber(latestBlockNumber, false);
+    ETH_ERROR_REQUIRE_MESSAGE(remoteBlockInfo.getTransactionCount() == 1,
+        "Failed to execute transaction on remote client! State test transaction must be valid!");
+    if (Options::get().vmtrace && !Options::get().filltests)
+        printVmTrace(_session, trHash, postHash);
+    validatePostHash(_session, postHash, remoteBlockInfo);
+
+    // Validate log hash
+    string postLogHash = _result.getData().atKey("logs").asString();
+    string remoteLogHash = _session.test_getLogHash(trHash);
+    if (!remoteLogHash.empty() && remoteLogHash != postLogHash)
+        ETH_ERROR_MESSAGE("Logs hash mismatch: '" + remoteLogHash + "', expected: '" + postLogHash + "'");
+
+    _session.test_rewindToBlock(0);
+    ETH_LOG("Executed: d: " + to_string(_tr.dataInd) + ", g: " + to_string(_tr.gasInd) +
+                ", v: " + to_string(_tr.valueInd) + ", fork: " + _network,
+        5);
+}
+
 /// Read and execute the test file
 void RunTest(DataObject const& _testFile)
 {
     test::scheme_stateTest test(_testFile);
     SessionInterface& session = RPCSession::instance(TestOutputHelper::getThreadID());
+    bool const asUnits = executeAsUnits();
+    std::vector<TransactionUnit> units;
+    signTransactions(test);
 
     // read post state results
     for (auto const& post: test.getPost().getResults())
@@ -264,20 +477,32 @@ void RunTest(DataObject const& _testFile)
         if ((!Options::get().singleTestNet.empty() && Options::get().singleTestNet != network) ||
             !inArray(Options::getDynamicOptions().getCurrentConfig().getNetworks(), network))
             networkSkip = true;
-        else
+        else if (!asUnits)
+        {
             session.test_setChainParams(test.getGenesisForRPC(network, "NoReward"));
+            auto const& results = post.second;
+            prepareTransactions(
+                session, test, [&results](scheme_generalTransaction::transactionInfo const& _tr) {
+                    for (auto const& result : results)
+                        if (result.checkIndexes(_tr.dataInd, _tr.gasInd, _tr.valueInd))
+                            return true;
+                    return false;
+                });
+        }
 
         // One test could have many transactions on same chainParams
         // It is expected that for a setted chainParams there going to be a transaction
         // Rather then all transactions would be filtered out and not executed at all
 
         // read all results for a specific fork
-        for (auto const& result: post.second)
+        for (size_t resultInd = 0; resultInd < post.second.size(); resultInd++)
         {
+            auto const& result = post.second.at(resultInd);
             bool resultHaveCorrespondingTransaction = false;
             // look for a transaction with this indexes and execute it on a client
-            for (auto& tr: test.getTransactionsUnsafe())
+            for (size_t trInd = 0; trInd < test.getTransactions().size(); trInd++)
             {
+                auto& tr = test.getTransactionsUnsafe().at(trInd);
                 TestInfo errorInfo (network, tr.dataInd, tr.gasInd, tr.valueInd);
                 TestOutputHelper::get().setCurrentTestInfo(errorInfo);
                 bool checkIndexes = result.checkIndexes(tr.dataInd, tr.gasInd, tr.valueInd);
@@ -292,33 +517,13 @@ void RunTest(DataObject const& _testFile)
 
                 if (checkIndexes)
                 {
-                    u256 a(test.getEnv().getData().atKey("currentTimestamp").asString());
-                    session.test_modifyTimestamp(a.convert_to<size_t>());
-                    string trHash = session.eth_sendRawTransaction(tr.transaction);
-                    string latestBlockNumber = session.test_mineBlocks(1);
-                    tr.executed = true;
-
-                    // Validate post state
-                    string postHash = result.getData().atKey("hash").asString();
-                    scheme_RPCBlock remoteBlockInfo =
-                        session.eth_getBlockByNumber(latestBlockNumber, false);
-                    ETH_ERROR_REQUIRE_MESSAGE(remoteBlockInfo.getTransactionCount() == 1,
-                        "Failed to execute transaction on remote client! State test transaction must be valid!");
-                    if (Options::get().vmtrace && !Options::get().filltests)
-                        printVmTrace(session, trHash, postHash);
-                    validatePostHash(session, postHash, remoteBlockInfo);
-
-                    // Validate log hash
-                    string postLogHash = result.getData().atKey("logs").asString();
-                    string remoteLogHash = session.test_getLogHash(trHash);
-                    if (!remoteLogHash.empty() && remoteLogHash != postLogHash)
-                        ETH_ERROR_MESSAGE("Logs hash mismatch: '" + remoteLogHash + "', expected: '" + postLogHash + "'");
-
-                    session.test_rewindToBlock(0);
-                    if (Options::get().logVerbosity >= 5)
-                        ETH_LOG("Executed: d: " + to_string(tr.dataInd) +
-                                    ", g: " + to_string(tr.gasInd) +
-                                    ", v: " + to_string(tr.valueInd) + ", fork: " + network, 5);
+                    if (asUnits)
+                        units.push_back(TransactionUnit(network, resultInd, trInd));
+                    else
+                    {
+                        tr.executed = true;
+                        RunTransaction(session, test, network, result, tr);
+                    }
                 }
             } //ForTransactions
             ETH_ERROR_REQUIRE_MESSAGE(resultHaveCorrespondingTransaction,
@@ -326,6 +531,17 @@ void RunTest(DataObject const& _testFile)
         }
     }
 
+    if (asUnits)
+    {
+        executeUnits(test, units, [&test](SessionInterface& _session, TransactionUnit& _unit) {
+            RunTransaction(_session, test, _unit.network,
+                test.getPost().getResults().at(_unit.network).at(_unit.sectionInd),
+                test.getTransactions().at(_unit.trInd));
+        });
+        for (auto const& unit : units)
+            test.getTransactionsUnsafe().at(unit.trInd).executed = true;
+    }
+
     test.checkUnexecutedTransactions();
 }
 }  // namespace closed
@@ -345,6 +561,7 @@ DataObject StateTestSuite::doTests(DataObject const& _input, TestSuiteOptions& _
     string const testname = inputTest.getKey();
     if (!TestOutputHelper::get().checkTest(testname))
         return filledTest;
+    PhaseTimer testTimer(TestPhase::Test);
 
     if (_opt.doFilling)
     {
@@ -1,6 +1,7 @@
 #include "BlockchainTestLogic.h"
 #include "fillers/BlockchainTestFillerLogic.h"
 #include <retesteth/EthChecks.h>
+#include <retesteth/TestTrace.h>
 #include <retesteth/session/RPCSession.h>
 #include <retesteth/testSuites/Common.h>
 
@@ -203,10 +204,7 @@ void RunTest(DataObject const& _testObject, TestSuite::TestSuiteOptions const& _
     // std::this_thread::sleep_for(std::chrono::seconds(10));
 
     scheme_RPCBlock latestBlock = session.eth_getBlockByNumber(session.eth_blockNumber(), false);
-    if (inputTest.getPost().isHash())
-        validatePostHash(session, inputTest.getPost().getHash(), latestBlock);
-    else
-        compareStates(scheme_expectState(inputTest.getPost().getData()), session, latestBlock);
+    validatePostState(session, inputTest.getPost(), latestBlock);
 
     if (inputTest.getLastBlockHash() != latestBlock.getBlockHash())
         ETH_ERROR_MESSAGE("lastblockhash does not match! remote: " + latestBlock.getBlockHash() +
@@ -242,6 +240,7 @@ DataObject DoTests(DataObject const& _input, TestSuite::TestSuiteOptions& _opt)
     {
         string const& testname = i.getKey();
         TestOutputHelper::get().setCurrentTestName(testname);
+        PhaseTimer testTimer(TestPhase::Test);
 
         if (_opt.doFilling)
         {
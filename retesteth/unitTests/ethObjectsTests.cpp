@@ -20,6 +20,7 @@
 
 #include <retesteth/TestOutputHelper.h>
 #include <retesteth/ethObjects/common.h>
+#include <retesteth/ethObjects/stateTest/NativeState.h>
 #include <retesteth/testSuites/Common.h>
 #include <boost/test/unit_test.hpp>
 #include <thread>
@@ -505,6 +506,10 @@ BOOST_AUTO_TEST_CASE(compareStates_storageCombinations)
     ExpectVsPost("0x", "0x01", "0x00", "0x01", CompareResult::Success);
     ExpectVsPost("0x00", "0x01", "0x00", "0x01", CompareResult::Success);
 
+    // Remote state lists a zero value
+    ExpectVsPost("0x01", "0x00", "0x01", "0x00", CompareResult::IncorrectStorage);
+    ExpectVsPost("--", "--", "0x01", "0x00", CompareResult::IncorrectStorage);
+
     // Double layer
     ExpectVsPost("0x", "0x", "--", "--", CompareResult::IncorrectStorage, "0x03");
     ExpectVsPost("0x", "0x00", "--", "--", CompareResult::IncorrectStorage, "0x03");
@@ -521,4 +526,120 @@ BOOST_AUTO_TEST_CASE(compareStates_storageCombinations)
     ExpectVsPost("0x00", "0x01", "0x00", "0x01", CompareResult::IncorrectStorage, "0x03");
 }
 
+BOOST_AUTO_TEST_CASE(nativeState_normalizesValues)
+{
+    DataObject postStorage;
+    postStorage["0x"] = "0x01";
+    postStorage["0x0002"] = "0x00";
+    postStorage["0x03"] = "0x0003";
+    DataObject postData;
+    postData["0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b"]["balance"] = "0x082124";
+    postData["0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b"]["code"] = "0x1234";
+    postData["0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b"]["nonce"] = "0x01";
+    postData["0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b"]["storage"] = postStorage;
+    NativeState const state((scheme_state(postData)));
+
+    NativeAccount const* account =
+        state.getAccount(Address("0xA94F5374FCE5EDBC8E2A8697C15331677E6EBF0B"));
+    BOOST_REQUIRE(account != nullptr);
+    BOOST_CHECK(account->balance == 0x82124);
+    BOOST_CHECK(account->nonce == 1);
+    BOOST_CHECK(account->code == fromHex("0x1234"));
+    BOOST_CHECK(account->codeHash == sha3(fromHex("0x1234")));
+    // zero values are kept, a client must not return them
+    BOOST_CHECK_EQUAL(account->storage.size(), 3);
+    BOOST_CHECK(account->storage.at(h256(0)) == 1);
+    BOOST_CHECK(account->storage.at(h256(2)) == 0);
+    BOOST_CHECK(account->storage.at(h256(3)) == 3);
+    BOOST_CHECK(state.getAccount(Address("0xb94f5374fce5edbc8e2a8697c15331677e6ebf0b")) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(stateComparator_streamsAccounts)
+{
+    Address const a("0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b");
+    Address const b("0xb94f5374fce5edbc8e2a8697c15331677e6ebf0b");
+    Address const c("0xc94f5374fce5edbc8e2a8697c15331677e6ebf0b");
+    NativeAccount account;
+    account.balance = 0x82123;
+
+    DataObject expectData;
+    expectData["0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b"]["balance"] = "0x82123";
+    {
+        // the rest of the state is not needed once all expected accounts are compared
+        StateComparator comparator((scheme_expectState(expectData)));
+        BOOST_CHECK(!comparator.isExpected(c));
+        BOOST_CHECK(comparator.compare(c, account));
+        BOOST_CHECK(comparator.isExpected(a));
+        BOOST_CHECK(!comparator.compare(a, account));
+        comparator.finish();
+    }
+
+    expectData["0xb94f5374fce5edbc8e2a8697c15331677e6ebf0b"]["shouldnotexist"] = "1";
+    {
+        // absence of an account is known at the end of the state only
+        StateComparator comparator((scheme_expectState(expectData)));
+        BOOST_CHECK(comparator.compare(a, account));
+        BOOST_CHECK(comparator.compare(c, account));
+        comparator.finish();
+    }
+
+    try
+    {
+        StateComparator comparator((scheme_expectState(expectData)));
+        comparator.compare(b, account);
+        comparator.finish();
+        BOOST_ERROR("StateComparator expected to fail");
+    }
+    catch (test::BaseEthException const& _ex)
+    {
+        // b must not exist, a is missing
+        BOOST_CHECK(string(_ex.what()).rfind("MissingExpectedAccount") != string::npos);
+        BOOST_CHECK_EQUAL(TestOutputHelper::get().getErrors().size(), 3);
+    }
+    TestOutputHelper::get().resetErrors();
+}
+
+// Signed transactions are shared for the whole run, the data is unique for this test
+DataObject makeTestTransaction(string const& _value)
+{
+    DataObject tr;
+    tr["data"] = toHexPrefixed(sha3("scheme_transaction_signedOnce").asBytes());
+    tr["gasLimit"] = "0x061a80";
+    tr["gasPrice"] = "0x01";
+    tr["nonce"] = "0x00";
+    tr["secretKey"] = "0x45a915e4d060149eb4365960e6a7a45f334393093061116b197e3240065ff2d8";
+    tr["to"] = "0x095e7baea6a9c7c4c2dfeb977efac326af552d87";
+    tr["value"] = _value;
+    return tr;
+}
+
+BOOST_AUTO_TEST_CASE(scheme_transaction_signedOnce)
+{
+    scheme_transaction tr(makeTestTransaction("0x0186a0"));
+    size_t const signaturesBefore = scheme_transaction::signaturesPerformed();
+    string const hash = tr.getHash();
+    string const rlp = tr.getSignedRLP();
+    BOOST_CHECK_EQUAL(scheme_transaction::signaturesPerformed(), signaturesBefore + 1);
+
+    // Copies and equal transactions reuse the signature
+    scheme_transaction trCopy = tr;
+    scheme_transaction trEqual(makeTestTransaction("0x0186a0"));
+    BOOST_CHECK(trCopy.getHash() == hash);
+    BOOST_CHECK(trEqual.getHash() == hash);
+    BOOST_CHECK(trEqual.getSignedRLP() == rlp);
+    BOOST_CHECK(dev::toHexPrefixed(dev::sha3(dev::fromHex(rlp))) == hash);
+    BOOST_CHECK_EQUAL(scheme_transaction::signaturesPerformed(), signaturesBefore + 1);
+
+    SignatureStruct sig;
+    tr.getSignedRLP(&sig);
+    DataObject const bcData = trEqual.getDataForBCTest();
+    BOOST_CHECK(bcData.atKey("v").asString() == toCompactHexPrefixed(27 + int(sig.v)));
+    BOOST_CHECK(bcData.atKey("r").asString() == toCompactHexPrefixed(sig.r, 1));
+    BOOST_CHECK(!bcData.count("secretKey"));
+
+    scheme_transaction trOther(makeTestTransaction("0x0186a1"));
+    BOOST_CHECK(trOther.getHash() != hash);
+    BOOST_CHECK_EQUAL(scheme_transaction::signaturesPerformed(), signaturesBefore + 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,159 @@
+/*
+    This file is part of cpp-ethereum.
+
+    cpp-ethereum is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    cpp-ethereum is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with cpp-ethereum.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file hexTests.cpp
+ * Unit tests for the hex encode, decode and canonicalization kernels.
+ */
+
+#include <libdevcore/CommonData.h>
+#include <libdevcore/Exceptions.h>
+#include <retesteth/TestHelper.h>
+#include <retesteth/TestOutputHelper.h>
+#include <retesteth/ethObjects/object.h>
+#include <retesteth/unitTests/unitTestHelper.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace dev;
+using namespace test;
+
+namespace
+{
+vector<SimdKernel> const c_kernels = {SimdKernel::Scalar, SimdKernel::SSE4, SimdKernel::AVX2};
+
+bytes makeBytes(size_t _size)
+{
+    bytes data(_size);
+    for (size_t i = 0; i < _size; i++)
+        data[i] = (byte)(i * 37 + _size * 11);
+    return data;
+}
+
+string encode(bytes const& _data, SimdKernel _kernel)
+{
+    string hex(_data.size() * 2, '?');
+    hexEncode(_data.data(), _data.size(), &hex[0], _kernel);
+    return hex;
+}
+
+string canonical(string const& _value, void (*_modifier)(DataObject&))
+{
+    DataObject obj("value", _value);
+    obj.performModifier(_modifier);
+    return obj.asString();
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(HexSuite, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(hex_knownAnswers)
+{
+    BOOST_CHECK_EQUAL(toHex(asBytes("A\x69")), "4169");
+    BOOST_CHECK_EQUAL(toHexPrefixed(bytes()), "0x");
+    BOOST_CHECK(fromHex("41626261") == asBytes("Abba"));
+    BOOST_CHECK(fromHex("0x123") == bytes({0x01, 0x23}));
+    BOOST_CHECK(fromHex("0xABcd") == bytes({0xab, 0xcd}));
+    BOOST_CHECK(fromHex("0x").empty());
+    BOOST_CHECK(fromHex("0x1g").empty());
+    BOOST_CHECK_THROW(fromHex("0x1g", WhenError::Throw), BadHexCharacter);
+    BOOST_CHECK_THROW(fromHex("g12", WhenError::Throw), BadHexCharacter);
+
+    BOOST_CHECK(isHex("0x"));
+    BOOST_CHECK(isHex("0x0123456789abcdefABCDEF"));
+    BOOST_CHECK(!isHex("0x0123456789abcdefg"));
+    BOOST_CHECK(!isHex("x0"));
+
+    h256 const hash("0x4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45");
+    BOOST_CHECK_EQUAL(hash.hex(), "4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45");
+}
+
+BOOST_AUTO_TEST_CASE(hex_kernelsEqualScalar)
+{
+    forEachSupportedKernel(c_kernels, [](SimdKernel _kernel) {
+        // sizes around the vector widths, so that the scalar tail is used
+        for (size_t size = 0; size <= 100; size++)
+        {
+            bytes const data = makeBytes(size);
+            string const hex = encode(data, SimdKernel::Scalar);
+            string const message = simdKernelName(_kernel) + " size " + toString(size);
+            BOOST_CHECK_MESSAGE(encode(data, _kernel) == hex, message);
+
+            string upper = hex;
+            std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+            bytes decoded(size);
+            BOOST_CHECK_MESSAGE(hexDecode(upper.data(), upper.size(), decoded.data(), _kernel), message);
+            BOOST_CHECK_MESSAGE(decoded == data, message);
+            BOOST_CHECK_MESSAGE(isHexDigits(upper.data(), upper.size(), _kernel), message);
+
+            // characters next to the hex digit ranges, at every position
+            for (size_t pos = 0; pos < hex.size(); pos++)
+                for (char bad : {'/', ':', '@', 'G', '`', 'g', ' ', '\x80'})
+                {
+                    string badHex = hex;
+                    badHex[pos] = bad;
+                    BOOST_CHECK_MESSAGE(!isHexDigits(badHex.data(), badHex.size(), _kernel), message);
+                    BOOST_CHECK_MESSAGE(!hexDecode(badHex.data(), badHex.size(), decoded.data(), _kernel), message);
+                }
+        }
+    });
+}
+
+BOOST_AUTO_TEST_CASE(hex_canonicalizeInPlace)
+{
+    string value = "0xABcdEF-XYZ";
+    toLowerCase(value);
+    BOOST_CHECK_EQUAL(value, "0xabcdef-xyz");
+
+    BOOST_CHECK_EQUAL(canonical("0xABCDEF", mod_valuesToLowerCase), "0xabcdef");
+    BOOST_CHECK_EQUAL(canonical("0x0004", mod_removeLeadingZerosFromHexValues), "0x4");
+    BOOST_CHECK_EQUAL(canonical("0x0010", mod_removeLeadingZerosFromHexValues), "0x10");
+    BOOST_CHECK_EQUAL(canonical("0x000", mod_removeLeadingZerosFromHexValues), "0x0");
+    BOOST_CHECK_EQUAL(canonical("0x0", mod_removeLeadingZerosFromHexValues), "0x0");
+    BOOST_CHECK_EQUAL(canonical("0x", mod_removeLeadingZerosFromHexValues), "0x");
+    BOOST_CHECK_EQUAL(canonical("00004", mod_removeLeadingZerosFromHexValues), "00004");
+
+    // byte fields keep their leading zeros
+    DataObject data("data", "0x0004");
+    data.performModifier(mod_removeLeadingZerosFromHexValues);
+    BOOST_CHECK_EQUAL(data.asString(), "0x0004");
+}
+
+BOOST_AUTO_TEST_CASE(hex_benchmark)
+{
+    if (!benchmarksEnabled())
+        return;
+
+    // hashes, addresses and contract code
+    for (size_t size : {32, 20, 24576})
+    {
+        size_t const count = 2000000 / size;
+        vector<bytes> inputs(count, makeBytes(size));
+        vector<string> hexes(count, string(size * 2, '0'));
+        forEachSupportedKernel(c_kernels, [&](SimdKernel _kernel) {
+            benchmark("hex " + simdKernelName(_kernel) + " encode and decode of " +
+                          toString(count) + " x " + toString(size) + " bytes",
+                [&]() {
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        hexEncode(inputs[i].data(), size, &hexes[i][0], _kernel);
+                        hexDecode(hexes[i].data(), hexes[i].size(), inputs[i].data(), _kernel);
+                    }
+                });
+        }, false);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,229 @@
+/*
+    This file is part of cpp-ethereum.
+
+    cpp-ethereum is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    cpp-ethereum is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with cpp-ethereum.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file rlpTests.cpp
+ * Unit tests for the RLP integer encoding and the stream buffer.
+ */
+
+#include <libdevcore/CommonData.h>
+#include <libdevcore/RLP.h>
+#include <retesteth/TestOutputHelper.h>
+#include <retesteth/ethObjects/common.h>
+#include <retesteth/session/BlockRLPView.h>
+#include <retesteth/unitTests/unitTestHelper.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace dev;
+using namespace test;
+
+namespace
+{
+// Values around the byte and limb boundaries
+vector<u256> makeValues()
+{
+    vector<u256> values = {0, 1, 0x7f, 0x80, 0xff, 0x100, ~u256(0)};
+    for (unsigned i = 0; i < 256; i++)
+    {
+        values.push_back(u256(1) << i);
+        values.push_back((u256(1) << i) - 1);
+        values.push_back((u256(0x1234567) << i) & ~u256(0));
+    }
+    return values;
+}
+
+bytes bigintRLP(bigint const& _value)
+{
+    return RLPStream().append(_value).out();
+}
+
+DataObject makeHeader()
+{
+    DataObject header;
+    header["parentHash"] = "0x" + string(64, '1');
+    header["uncleHash"] = "0x" + string(64, '2');
+    header["coinbase"] = "0x" + string(40, 'a');
+    header["stateRoot"] = "0x" + string(64, '3');
+    header["transactionsTrie"] = "0x" + string(64, '4');
+    header["receiptTrie"] = "0x" + string(64, '5');
+    header["bloom"] = "0x" + string(512, '0');
+    header["difficulty"] = "0x020000";
+    header["number"] = "0x01";
+    header["gasLimit"] = "0x7fffffff";
+    header["gasUsed"] = "0x0";
+    header["timestamp"] = "0x03e8";
+    header["extraData"] = "0x0042";
+    header["mixHash"] = "0x" + string(64, '6');
+    header["nonce"] = "0x0102030405060708";
+    return header;
+}
+
+// Header rlp with the field _index replaced by _rlp
+bytes headerWithField(size_t _index, bytes const& _rlp)
+{
+    bytes const header = scheme_RPCBlock::streamBlockHeader(makeHeader()).out();
+    RLPStream stream(15);
+    size_t i = 0;
+    for (auto const& field : RLP(header))
+    {
+        if (i++ == _index)
+            stream.appendRaw(_rlp);
+        else
+            stream.appendRaw(field.data());
+    }
+    return stream.out();
+}
+
+// Block with one transaction and no uncles
+bytes makeBlock(bytes const& _header)
+{
+    RLPStream block(3);
+    block.appendRaw(_header);
+    block.appendList(1);
+    block.appendList(9) << u256(1) << u256(10) << u256(21000) << Address(0x0a) << u256(0)
+                        << bytes() << unsigned(27) << u256(2) << u256(3);
+    block.appendList(0);
+    return block.out();
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(RLPSuite, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(rlp_knownAnswers)
+{
+    BOOST_CHECK_EQUAL(toHex(rlp(u256(0))), "80");
+    BOOST_CHECK_EQUAL(toHex(rlp(u256(0x7f))), "7f");
+    BOOST_CHECK_EQUAL(toHex(rlp(u256(0x80))), "8180");
+    BOOST_CHECK_EQUAL(toHex(rlp(u256(0x0400))), "820400");
+    BOOST_CHECK_EQUAL(toHex(rlp(unsigned(0))), "80");
+    BOOST_CHECK_EQUAL(toHex(rlp(unsigned(1024))), "820400");
+    BOOST_CHECK_EQUAL(toHex(rlp(~u256(0))), "a0" + string(64, 'f'));
+}
+
+BOOST_AUTO_TEST_CASE(rlp_fixedWidthEqualsBigint)
+{
+    for (u256 const& value : makeValues())
+    {
+        bytes const encoded = rlp(value);
+        BOOST_CHECK_MESSAGE(encoded == bigintRLP(value), "u256 " + toString(value));
+        BOOST_CHECK(RLP(encoded).toInt<u256>() == value);
+
+        u160 const value160 = u160(value & ((u256(1) << 160) - 1));
+        BOOST_CHECK_MESSAGE(rlp(value160) == bigintRLP(value160), "u160 " + toString(value160));
+
+        unsigned const value32 = (unsigned)(value & 0xffffffff);
+        BOOST_CHECK_MESSAGE(rlp(value32) == bigintRLP(value32), "unsigned " + toString(value32));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(rlp_callerBuffer)
+{
+    bytes buffer;
+    buffer.reserve(1024);
+    byte const* data = buffer.data();
+    for (size_t i = 0; i < 3; i++)
+    {
+        RLPStream stream(std::move(buffer));
+        stream.reserve(512);
+        stream.appendList(2) << u256(5);
+        stream.appendList(1) << "abc";
+        BOOST_CHECK_EQUAL(toHex(stream.out()), "c605c483616263");
+        stream.swapOut(buffer);
+    }
+    // the same memory is used by every stream
+    BOOST_CHECK(buffer.data() == data);
+    BOOST_CHECK_EQUAL(buffer.capacity(), size_t(1024));
+}
+
+BOOST_AUTO_TEST_CASE(blockView_fields)
+{
+    DataObject const headerData = makeHeader();
+    bytes const header = scheme_RPCBlock::streamBlockHeader(headerData).out();
+    bytes const blockBytes = makeBlock(header);
+    toolimpl::BlockView const block(&blockBytes);
+
+    toolimpl::BlockHeaderView const& view = block.header();
+    BOOST_CHECK(view.raw() == bytesConstRef(&header));
+    BOOST_CHECK(view.hash() == sha3(header));
+    BOOST_CHECK(view.parentHash() == h256(headerData.atKey("parentHash").asString()));
+    BOOST_CHECK(view.coinbase() == Address(headerData.atKey("coinbase").asString()));
+    BOOST_CHECK(view.difficulty() == 0x20000);
+    BOOST_CHECK(view.gasUsed() == 0);
+    BOOST_CHECK(view.timestamp() == 1000);
+    BOOST_CHECK(view.extraData().toBytes() == bytes({0x00, 0x42}));
+    BOOST_CHECK(view.nonce() == h64("0x0102030405060708"));
+
+    // Fields are hex of the rlp as clients return them, the hash is the one of raw rlp
+    DataObject const data = view.toData();
+    BOOST_CHECK_EQUAL(data.atKey("number").asString(), "0x01");
+    BOOST_CHECK_EQUAL(data.atKey("gasUsed").asString(), "0x0");
+    BOOST_CHECK_EQUAL(data.atKey("extraData").asString(), "0x0042");
+    BOOST_CHECK_EQUAL(data.atKey("hash").asString(), toHexPrefixed(sha3(header)));
+    BOOST_CHECK(scheme_RPCBlock::streamBlockHeader(data).out() == header);
+
+    BOOST_REQUIRE_EQUAL(block.transactions().size(), 1);
+    BOOST_CHECK(block.uncles().empty());
+    toolimpl::TransactionView const& transaction = block.transactions().at(0);
+    BOOST_CHECK(transaction.gasLimit() == 21000);
+    BOOST_CHECK(transaction.hash() == sha3(transaction.raw()));
+    DataObject const trData = transaction.toData();
+    BOOST_CHECK_EQUAL(trData.atKey("to").asString(), toHexPrefixed(Address(0x0a)));
+    BOOST_CHECK_EQUAL(trData.atKey("value").asString(), "0x0");
+    BOOST_CHECK_EQUAL(trData.atKey("data").asString(), "");
+    BOOST_CHECK_EQUAL(trData.atKey("v").asString(), "0x1b");
+}
+
+BOOST_AUTO_TEST_CASE(blockView_rejectsMalformed)
+{
+    // integers with leading zeros and hashes of wrong size would hash differently
+    bytes const leadingZero = makeBlock(headerWithField(8, rlp(bytes({0x00, 0x01}))));
+    bytes const shortHash = makeBlock(headerWithField(0, rlp(bytes(31))));
+    bytes const listField = makeBlock(headerWithField(12, rlpList()));
+    bytes const notList = rlp(u256(1));
+    bytes const shortList = rlpList(bytes(), bytes());
+
+    for (bytes const* block : {&leadingZero, &shortHash, &listField, &notList, &shortList})
+        BOOST_CHECK_THROW(toolimpl::BlockView{block}, RLPException);
+}
+
+BOOST_AUTO_TEST_CASE(rlp_benchmark)
+{
+    if (!benchmarksEnabled())
+        return;
+
+    // fields of a transaction
+    vector<u256> values;
+    for (size_t i = 0; i < 1000000; i++)
+        values.push_back(u256(i) * u256(i) * 1000000007);
+
+    bytes buffer;
+    string const what = "RLP of " + toString(values.size()) + " u256 values";
+    benchmark(what, [&]() {
+        RLPStream stream(std::move(buffer));
+        for (auto const& value : values)
+            stream << value;
+        stream.swapOut(buffer);
+    });
+
+    RLPStream stream;
+    benchmark(what + " with bigint", [&]() {
+        for (auto const& value : values)
+            stream.append(bigint(value));
+    });
+    BOOST_CHECK(stream.out() == buffer);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,116 @@
+/*
+    This file is part of cpp-ethereum.
+
+    cpp-ethereum is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    cpp-ethereum is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with cpp-ethereum.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file sha3Tests.cpp
+ * Unit tests for the batch sha3 kernels.
+ */
+
+#include <libdevcore/RLP.h>
+#include <libdevcore/SHA3.h>
+#include <retesteth/TestOutputHelper.h>
+#include <retesteth/unitTests/unitTestHelper.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace dev;
+using namespace test;
+
+namespace
+{
+vector<SimdKernel> const c_kernels = {SimdKernel::Scalar, SimdKernel::AVX2, SimdKernel::AVX512};
+
+// Inputs around the block size (136 bytes) and the padding edge cases
+vector<bytes> makeInputs()
+{
+    vector<bytes> inputs;
+    for (size_t size = 0; size <= 3 * 136 + 1; size++)
+    {
+        bytes input(size);
+        for (size_t i = 0; i < size; i++)
+            input[i] = (byte)(i * 31 + size);
+        inputs.push_back(input);
+    }
+    return inputs;
+}
+
+vector<bytesConstRef> refs(vector<bytes> const& _inputs)
+{
+    vector<bytesConstRef> ret;
+    for (auto const& input : _inputs)
+        ret.emplace_back(&input);
+    return ret;
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(SHA3Suite, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(sha3_knownAnswers)
+{
+    BOOST_CHECK(sha3(bytesConstRef()) ==
+                h256("0xc5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470"));
+    BOOST_CHECK(sha3(asBytes("abc")) ==
+                h256("0x4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45"));
+    BOOST_CHECK(sha3(rlpList()) == EmptyListSHA3);
+
+    vector<bytes> const inputs = {bytes(), asBytes("abc"), rlpList()};
+    vector<bytesConstRef> const inputRefs = refs(inputs);
+    // kernels the CPU does not support fall back to the scalar one
+    for (auto kernel : c_kernels)
+    {
+        vector<h256> hashes(inputs.size());
+        sha3_many(inputRefs.data(), inputRefs.size(), hashes.data(), kernel);
+        BOOST_CHECK_MESSAGE(hashes[0] == EmptySHA3, simdKernelName(kernel));
+        BOOST_CHECK_MESSAGE(hashes[1] == sha3(asBytes("abc")), simdKernelName(kernel));
+        BOOST_CHECK_MESSAGE(hashes[2] == EmptyListSHA3, simdKernelName(kernel));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sha3_manyEqualsSha3)
+{
+    vector<bytes> const inputs = makeInputs();
+    vector<bytesConstRef> const inputRefs = refs(inputs);
+    forEachSupportedKernel(c_kernels, [&](SimdKernel _kernel) {
+        // every batch size, so that inputs fill the lanes partially
+        for (size_t count : {inputs.size(), size_t(1), size_t(3), size_t(5), size_t(9)})
+        {
+            vector<h256> hashes(count);
+            sha3_many(inputRefs.data(), count, hashes.data(), _kernel);
+            for (size_t i = 0; i < count; i++)
+                BOOST_CHECK_MESSAGE(hashes[i] == sha3(inputRefs[i]),
+                    simdKernelName(_kernel) + " input size " + toString(inputs[i].size()));
+        }
+    });
+    BOOST_CHECK(sha3_many(inputRefs).size() == inputs.size());
+}
+
+BOOST_AUTO_TEST_CASE(sha3_benchmark)
+{
+    if (!benchmarksEnabled())
+        return;
+
+    // transaction sized inputs
+    vector<bytes> inputs(100000, bytes(110));
+    for (size_t i = 0; i < inputs.size(); i++)
+        inputs[i][i % 110] = (byte)i;
+    vector<bytesConstRef> const inputRefs = refs(inputs);
+    vector<h256> hashes(inputs.size());
+    forEachSupportedKernel(c_kernels, [&](SimdKernel _kernel) {
+        benchmark("sha3_many " + simdKernelName(_kernel) + " of " + toString(inputs.size()) + " inputs",
+            [&]() { sha3_many(inputRefs.data(), inputRefs.size(), hashes.data(), _kernel); });
+    }, false);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
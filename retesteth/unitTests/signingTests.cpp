@@ -0,0 +1,122 @@
+/*
+    This file is part of cpp-ethereum.
+
+    cpp-ethereum is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    cpp-ethereum is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with cpp-ethereum.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file signingTests.cpp
+ * Unit tests for signing the transactions of a test at once.
+ */
+
+#include <libdevcore/SHA3.h>
+#include <retesteth/TestOutputHelper.h>
+#include <retesteth/WorkerPool.h>
+#include <retesteth/ethObjects/common.h>
+#include <retesteth/unitTests/unitTestHelper.h>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <thread>
+
+using namespace std;
+using namespace dev;
+using namespace test;
+
+namespace
+{
+// Signed transactions are shared for the whole run, every test case signs its own values
+vector<scheme_transaction> makeTransactions(string const& _test, size_t _count)
+{
+    vector<scheme_transaction> transactions;
+    for (size_t i = 0; i < _count; i++)
+    {
+        DataObject tr;
+        tr["data"] = toHexPrefixed(sha3(_test).asBytes());
+        tr["gasLimit"] = "0x061a80";
+        tr["gasPrice"] = "0x01";
+        tr["nonce"] = "0x00";
+        tr["secretKey"] = "0x45a915e4d060149eb4365960e6a7a45f334393093061116b197e3240065ff2d8";
+        tr["to"] = "0x095e7baea6a9c7c4c2dfeb977efac326af552d87";
+        tr["value"] = toCompactHexPrefixed(i + 1, 1);
+        transactions.push_back(scheme_transaction(tr));
+    }
+    return transactions;
+}
+
+vector<scheme_transaction const*> pointers(vector<scheme_transaction> const& _transactions)
+{
+    vector<scheme_transaction const*> result;
+    for (auto const& tr : _transactions)
+        result.push_back(&tr);
+    return result;
+}
+
+void signAllOnPool(vector<scheme_transaction const*> const& _transactions, size_t _threads)
+{
+    WorkerPool pool(_threads);
+    pool.addTask([&_transactions]() { scheme_transaction::signAll(_transactions); });
+    pool.wait();
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(SigningSuite, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(signing_signAll)
+{
+    vector<scheme_transaction> transactions = makeTransactions("signing_signAll", 32);
+    transactions.push_back(transactions.at(0));
+    vector<scheme_transaction> const equal = makeTransactions("signing_signAll", 32);
+    size_t const signatures = scheme_transaction::signaturesPerformed();
+
+    // distinct transactions are signed once on the pool
+    signAllOnPool(pointers(transactions), 4);
+    BOOST_CHECK_EQUAL(scheme_transaction::signaturesPerformed(), signatures + 32);
+
+    // equal transactions take the signed ones
+    size_t const hits = scheme_transaction::signedTransactionHits();
+    scheme_transaction::signAll(pointers(transactions));
+    for (size_t i = 0; i < equal.size(); i++)
+    {
+        BOOST_CHECK(equal.at(i).getHash() == transactions.at(i).getHash());
+        BOOST_CHECK(
+            equal.at(i).getHash() == toHexPrefixed(sha3(fromHex(equal.at(i).getSignedRLP()))));
+    }
+    BOOST_CHECK_EQUAL(scheme_transaction::signaturesPerformed(), signatures + 32);
+    BOOST_CHECK_EQUAL(scheme_transaction::signedTransactionHits(), hits + equal.size());
+}
+
+BOOST_AUTO_TEST_CASE(signing_benchmark)
+{
+    if (!benchmarksEnabled())
+        return;
+
+    size_t const count = 2000;
+    string const what = "Sign " + toString(count) + " transactions";
+    vector<scheme_transaction> const sequential = makeTransactions("signing_sequential", count);
+    benchmark(what + " one by one", [&]() {
+        for (auto const& tr : sequential)
+            tr.getHash();
+    });
+
+    vector<scheme_transaction> const batch = makeTransactions("signing_batch", count);
+    benchmark(what + " with signAll", [&]() {
+        signAllOnPool(pointers(batch), std::max(1u, std::thread::hardware_concurrency()));
+    });
+
+    vector<scheme_transaction> const equal = makeTransactions("signing_batch", count);
+    benchmark(what + " signed before", [&]() {
+        for (auto const& tr : equal)
+            tr.getHash();
+    });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
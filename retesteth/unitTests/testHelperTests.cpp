@@ -19,8 +19,15 @@
  */
 
 #include <retesteth/TestHelper.h>
+#include <retesteth/TestJournal.h>
 #include <retesteth/TestOutputHelper.h>
+#include <retesteth/TestShards.h>
+#include <retesteth/TestTimings.h>
+#include <retesteth/TestTrace.h>
+#include <retesteth/testSuites/Common.h>
+#include <dataObject/ConvertFile.h>
 #include <boost/test/unit_test.hpp>
+#include <thread>
 
 using namespace std;
 using namespace dev;
@@ -118,5 +125,209 @@ BOOST_AUTO_TEST_CASE(getTestSuggestions2)
     BOOST_CHECK(test::inArray(list, string("BCGeneralStateTests/stExample")));
 }
 
+BOOST_AUTO_TEST_CASE(predictMakespan_longestFirst)
+{
+    vector<double> const shortestFirst = {2, 2, 2, 3, 3, 4};
+    vector<double> const longestFirst = {4, 3, 3, 2, 2, 2};
+    BOOST_CHECK(test::predictMakespan(shortestFirst, 2) == 9);
+    BOOST_CHECK(test::predictMakespan(longestFirst, 2) == 8);
+    BOOST_CHECK(test::predictMakespan(longestFirst, 1) == 16);
+    BOOST_CHECK(test::predictMakespan(vector<double>(), 4) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(testTimings_estimateByFileSize)
+{
+    string const knownKey = "unitTestConfig:TestTimingsSuite/knownTest";
+    string const unknownKey = "unitTestConfig:TestTimingsSuite/unknownTest";
+    // not the timings of datadir, the file is never written
+    fs::path const tmpDir = test::createUniqueTmpDirectory();
+    test::TestTimings timings(tmpDir / "timings.json");
+    timings.add(knownKey, 2);
+
+    // unknown test is estimated with the seconds per byte of the known test
+    vector<double> const estimates = timings.estimate({knownKey, unknownKey}, {1000, 3000});
+    BOOST_CHECK(estimates.at(0) == 2);
+    BOOST_CHECK(estimates.at(1) == 6);
+    fs::remove_all(tmpDir);
+}
+
+BOOST_AUTO_TEST_CASE(shardOfTest_stable)
+{
+    size_t const shardCount = 4;
+    vector<size_t> testsPerShard(shardCount, 0);
+    for (size_t i = 0; i < 400; i++)
+    {
+        string const key = "stExample/test" + toString(i) + "Filler.json";
+        size_t const shard = test::shardOfTest(key, shardCount);
+        BOOST_CHECK(shard < shardCount);
+        BOOST_CHECK(shard == test::shardOfTest(key, shardCount));
+        testsPerShard.at(shard)++;
+    }
+    for (auto const& tests : testsPerShard)
+        BOOST_CHECK(tests > 50);
+    BOOST_CHECK(test::shardOfTest("stExample/test1Filler.json", 1) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(balanceShards_longestFirst)
+{
+    vector<string> const keys = {"a", "b", "c", "d", "e"};
+    vector<double> const estimates = {1, 5, 3, 3, 2};
+    vector<size_t> const shards = test::balanceShards(keys, estimates, 2);
+    vector<double> load(2, 0);
+    for (size_t i = 0; i < keys.size(); i++)
+        load.at(shards.at(i)) += estimates.at(i);
+    BOOST_CHECK(load.at(0) == 7);
+    BOOST_CHECK(load.at(1) == 7);
+    BOOST_CHECK(shards == test::balanceShards(keys, estimates, 2));
+}
+
+BOOST_AUTO_TEST_CASE(mergeShardResults_totals)
+{
+    DataObject shard1;
+    shard1["totalTestsRun"] = 10;
+    shard1["totalErrors"] = 1;
+    shard1["transactionSignatures"] = 100;
+    shard1["execTimes"]["stExample"] = 1500;
+    shard1["failedTests"]["test1"] = "info1";
+    DataObject shard2;
+    shard2["totalTestsRun"] = 5;
+    shard2["totalErrors"] = 0;
+    shard2["transactionSignatures"] = 50;
+    shard2["execTimes"]["stExample"] = 500;
+    shard2["execTimes"]["stOther"] = 100;
+    shard2["failedTests"] = DataObject(DataType::Object);
+
+    DataObject const merged = test::mergeShardResults({shard1, shard2});
+    BOOST_CHECK(merged.atKey("shards").asInt() == 2);
+    BOOST_CHECK(merged.atKey("totalTestsRun").asInt() == 15);
+    BOOST_CHECK(merged.atKey("totalErrors").asInt() == 1);
+    BOOST_CHECK(merged.atKey("transactionSignatures").asInt() == 150);
+    BOOST_CHECK(merged.atKey("execTimes").atKey("stExample").asInt() == 2000);
+    BOOST_CHECK(merged.atKey("execTimes").atKey("stOther").asInt() == 100);
+    BOOST_CHECK(merged.atKey("failedTests").atKey("test1").asString() == "info1");
+}
+
+BOOST_AUTO_TEST_CASE(testJournal_persistsKeys)
+{
+    fs::path const file = fs::temp_directory_path() / fs::unique_path() / "journal";
+    {
+        test::TestJournal journal(file);
+        BOOST_CHECK(!journal.contains("key1"));
+        journal.add("key1");
+        journal.add("key1");
+        journal.add("key2");
+        BOOST_CHECK(journal.contains("key1"));
+    }
+
+    // keys are read back by the next run
+    test::TestJournal journal(file);
+    BOOST_CHECK(journal.contains("key1"));
+    BOOST_CHECK(journal.contains("key2"));
+    BOOST_CHECK(!journal.contains("key3"));
+    BOOST_CHECK(dev::contentsString(file) == "key1\nkey2\n");
+    fs::remove_all(file.parent_path());
+}
+
+BOOST_AUTO_TEST_CASE(testJournal_filledEntryFollowsOutput)
+{
+    fs::path const dir = fs::temp_directory_path() / fs::unique_path();
+    fs::path const output = dir / "stExample.json";
+    BOOST_CHECK(test::filledTestEntry("fillerKey", output).empty());
+
+    fs::create_directories(dir);
+    dev::writeFile(output, string("{}"));
+    string const entry = test::filledTestEntry("fillerKey", output);
+    BOOST_CHECK(entry.find("fillerKey ") == 0);
+    BOOST_CHECK(test::filledTestEntry("fillerKey", output) == entry);
+
+    // changed output is not verified by the journal entry of the fill
+    dev::writeFile(output, string("{ }"));
+    BOOST_CHECK(test::filledTestEntry("fillerKey", output) != entry);
+    fs::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(phaseTrace_summaryAndChromeTrace)
+{
+    vector<PhaseEvent> events;
+    events.push_back(
+        PhaseEvent{TestPhase::Mine, "stExampleFiller.json", "stExample", 1, 10000, 5000});
+    events.push_back(
+        PhaseEvent{TestPhase::Mine, "stExampleFiller.json", "stExample", 1, 20000, 7000});
+    events.push_back(
+        PhaseEvent{TestPhase::Compare, "stExampleFiller.json", "stExample", 2, 30000, 3000});
+    // longer than INT_MAX microseconds
+    events.push_back(
+        PhaseEvent{TestPhase::File, "stExampleFiller.json", "", 2, 0, int64_t(3000000) * 1000});
+
+    DataObject const summary = test::phaseSummary(events);
+    DataObject const& file = summary.atKey("stExampleFiller.json");
+    BOOST_CHECK(file.atKey("stExample").atKey("mine").asInt() == 12);
+    BOOST_CHECK(file.atKey("stExample").atKey("compare").asInt() == 3);
+    BOOST_CHECK(file.atKey("_file").atKey("file").asInt() == 3000000);
+
+    string const csv = test::phaseEventsCSV(events);
+    BOOST_CHECK(csv.find("stExampleFiller.json,stExample,compare,2,30000,3000\n") != string::npos);
+
+    // 4 events and a track name for each of the 2 threads
+    DataObject const trace = ConvertJsoncppStringToData(test::phaseChromeTrace(events));
+    BOOST_CHECK(trace.atKey("traceEvents").getSubObjects().size() == 6);
+    BOOST_CHECK(trace.atKey("traceEvents").getSubObjects().at(0).atKey("ph").asString() == "X");
+}
+
+BOOST_AUTO_TEST_CASE(phaseTrace_recordScope)
+{
+    test::enablePhaseTrace(true);
+    size_t const eventsBefore = test::collectPhaseEvents().size();
+    {
+        PhaseTimer timer(TestPhase::Compile);
+    }
+    test::enablePhaseTrace(false);
+    {
+        PhaseTimer timer(TestPhase::Compile);
+    }
+    vector<PhaseEvent> const events = test::collectPhaseEvents();
+    BOOST_CHECK(events.size() == eventsBefore + 1);
+    BOOST_CHECK(events.back().threadID == TestOutputHelper::getThreadID());
+}
+
+BOOST_AUTO_TEST_CASE(rangePageSize_adapts)
+{
+    using namespace std::chrono;
+    RangePageSize pageSize;
+    BOOST_CHECK_EQUAL(pageSize.get(), 100);
+
+    // full and fast pages grow the page
+    pageSize.update(100, milliseconds(10));
+    BOOST_CHECK_EQUAL(pageSize.get(), 200);
+    // the last page is not full
+    pageSize.update(50, milliseconds(10));
+    BOOST_CHECK_EQUAL(pageSize.get(), 200);
+    // slow reply shrinks the page
+    pageSize.update(200, milliseconds(1000));
+    BOOST_CHECK_EQUAL(pageSize.get(), 100);
+
+    for (size_t i = 0; i < 20; i++)
+        pageSize.update(pageSize.get(), milliseconds(1));
+    BOOST_CHECK_EQUAL(pageSize.get(), RangePageSize::c_maxSize);
+    for (size_t i = 0; i < 20; i++)
+        pageSize.update(pageSize.get(), seconds(1));
+    BOOST_CHECK_EQUAL(pageSize.get(), RangePageSize::c_minSize);
+}
+
+BOOST_AUTO_TEST_CASE(testOutputHelper_reusedByNewThread)
+{
+    // helper of the exited thread is taken by the next one, with a clean test state
+    TestOutputHelper* first = nullptr;
+    std::thread([&first]() {
+        first = &TestOutputHelper::get();
+        first->setCurrentTestName("testOutputHelper_reusedByNewThread");
+    }).join();
+    TestOutputHelper* second = nullptr;
+    std::thread([&second]() { second = &TestOutputHelper::get(); }).join();
+    BOOST_CHECK(first == second);
+    BOOST_CHECK(second->testName().empty());
+    BOOST_CHECK(second != &TestOutputHelper::get());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,175 @@
+/*
+    This file is part of cpp-ethereum.
+
+    cpp-ethereum is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    cpp-ethereum is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with cpp-ethereum.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file trieTests.cpp
+ * Unit tests for the trie root and the state root computation.
+ */
+
+#include <libdevcore/RLP.h>
+#include <libdevcore/TrieHash.h>
+#include <retesteth/TestOutputHelper.h>
+#include <retesteth/ethObjects/common.h>
+#include <retesteth/unitTests/unitTestHelper.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace dev;
+using namespace test;
+
+namespace
+{
+h256 rootOf(StringMap const& _entries)
+{
+    BytesMap entries;
+    for (auto const& entry : _entries)
+        entries[asBytes(entry.first)] = asBytes(entry.second);
+    return trieRoot(entries);
+}
+
+DataObject makeAccount(string const& _address, string const& _balance)
+{
+    DataObject account;
+    account.setKey(_address);
+    account["balance"] = _balance;
+    account["code"] = "0x";
+    account["nonce"] = "0x00";
+    account["storage"] = DataObject(DataType::Object);
+    return account;
+}
+
+// State of _accounts accounts with 2 storage records each
+DataObject makeState(size_t _accounts)
+{
+    DataObject state;
+    for (size_t i = 0; i < _accounts; i++)
+    {
+        DataObject account =
+            makeAccount(toHexPrefixed(h160(u160(i + 1)).asBytes()), toCompactHexPrefixed(i + 1, 1));
+        account["storage"]["0x01"] = toCompactHexPrefixed(i + 1, 1);
+        account["storage"]["0x02"] = "0x02";
+        state.addSubObject(account);
+    }
+    return state;
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(TrieSuite, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(trieRoot_empty)
+{
+    BOOST_CHECK(EmptyTrie == h256("0x56e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421"));
+    BOOST_CHECK(trieRoot(BytesMap()) == EmptyTrie);
+    BOOST_CHECK(secureTrieRoot(BytesMap()) == EmptyTrie);
+    BOOST_CHECK(orderedTrieRoot(vector<bytes>()) == EmptyTrie);
+}
+
+BOOST_AUTO_TEST_CASE(trieRoot_dogs)
+{
+    StringMap const dogs = {{"doe", "reindeer"}, {"dog", "puppy"}, {"dogglesworth", "cat"}};
+    BOOST_CHECK(rootOf(dogs) ==
+                h256("0x8aad789dff2f538bca5d8ea56e8abe10f4c7ba3a5dea95fea4cd6e7c3a1168d3"));
+}
+
+BOOST_AUTO_TEST_CASE(trieRoot_puppy)
+{
+    // "do" is a prefix of the other keys, its value goes to the branch node
+    StringMap const puppy = {{"do", "verb"}, {"dog", "puppy"}, {"doge", "coin"}, {"horse", "stallion"}};
+    BOOST_CHECK(rootOf(puppy) ==
+                h256("0x5991bb8c6514148a29db676a14ac506cd2cd5775ace63c30a4fe457715e9ac84"));
+}
+
+BOOST_AUTO_TEST_CASE(secureTrieRoot_hashesKeys)
+{
+    BytesMap entries;
+    entries[asBytes("dog")] = asBytes("puppy");
+    BytesMap hashedEntries;
+    hashedEntries[sha3(asBytes("dog")).asBytes()] = asBytes("puppy");
+    BOOST_CHECK(secureTrieRoot(entries) == trieRoot(hashedEntries));
+}
+
+BOOST_AUTO_TEST_CASE(stateRoot_zeroStorageIsNotStored)
+{
+    DataObject empty = makeAccount("0x095e7baea6a6c7c4c2dfeb977efac326af552d87", "0x0de0b6b3a7640000");
+    DataObject zeroStorage = empty;
+    zeroStorage["storage"]["0x01"] = "0x00";
+    BOOST_CHECK(scheme_account(empty).storageRoot() == EmptyTrie);
+    BOOST_CHECK(scheme_account(zeroStorage).storageRoot() == EmptyTrie);
+
+    DataObject storage = empty;
+    storage["storage"]["0x01"] = "0x01";
+    BOOST_CHECK(scheme_account(storage).storageRoot() != EmptyTrie);
+}
+
+BOOST_AUTO_TEST_CASE(stateRoot_accountOrder)
+{
+    DataObject state;
+    state.addSubObject(makeAccount("0x095e7baea6a6c7c4c2dfeb977efac326af552d87", "0x01"));
+    state.addSubObject(makeAccount("0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b", "0x02"));
+    DataObject reversed;
+    reversed.addSubObject(state.getSubObjects().at(1));
+    reversed.addSubObject(state.getSubObjects().at(0));
+    h256 const root = scheme_state(state).stateRoot();
+    BOOST_CHECK(root == scheme_state(reversed).stateRoot());
+
+    DataObject changed = state;
+    changed.getSubObjectsUnsafe().at(0)["balance"] = "0x03";
+    BOOST_CHECK(root != scheme_state(changed).stateRoot());
+}
+
+BOOST_AUTO_TEST_CASE(stateRoot_addPreState)
+{
+    // pre state of stExample/add11, code is { [[0]] (ADD 1 1) }
+    DataObject pre;
+    DataObject contract = makeAccount("0x095e7baea6a6c7c4c2dfeb977efac326af552d87", "0x0de0b6b3a7640000");
+    contract["code"] = "0x600160010160005500";
+    pre.addSubObject(contract);
+    pre.addSubObject(makeAccount("0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b", "0x0de0b6b3a7640000"));
+    BOOST_CHECK(scheme_state(pre).stateRoot() ==
+                h256("0x23af372a0ccfd6a662f86652c982d9c769c0eb240428d6b124acd73a84057da5"));
+}
+
+BOOST_AUTO_TEST_CASE(stateRoot_accountWithStorageAndCode)
+{
+    DataObject account = makeAccount("0x095e7baea6a6c7c4c2dfeb977efac326af552d87", "0x0de0b6b3a7640000");
+    account["nonce"] = "0x01";
+    account["code"] = "0x600160010160005500";
+    account["storage"]["0x00"] = "0x02";
+    account["storage"]["0x01"] = "0x1234";
+    BOOST_CHECK(scheme_account(account).storageRoot() ==
+                h256("0xd17a987bd8e80428100f772379a17a305efb6df6fbd913f637603cc07a938c41"));
+
+    DataObject state;
+    state.addSubObject(account);
+    BOOST_CHECK(scheme_state(state).stateRoot() ==
+                h256("0x82f4f1da7bf67000f020fb0e23767aacde53b8a39161ab24fdd62a9366d76638"));
+}
+
+BOOST_AUTO_TEST_CASE(stateRoot_benchmark)
+{
+    if (!benchmarksEnabled())
+        return;
+
+    for (size_t accounts : {10000, 100000})
+    {
+        scheme_state const state(makeState(accounts));
+        h256 root;
+        benchmark("State root of " + toString(accounts) + " accounts",
+            [&]() { root = state.stateRoot(); });
+        BOOST_CHECK(root != EmptyTrie);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,57 @@
+/*
+    This file is part of cpp-ethereum.
+
+    cpp-ethereum is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    cpp-ethereum is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with cpp-ethereum.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file unitTestHelper.cpp
+ * Helpers shared by the unit tests of the SIMD kernels and by the benchmarks.
+ */
+
+#include <libdevcore/Common.h>
+#include <retesteth/EthChecks.h>
+#include <retesteth/Options.h>
+#include <retesteth/unitTests/unitTestHelper.h>
+
+using namespace std;
+using namespace dev;
+
+namespace test
+{
+bool benchmarksEnabled()
+{
+    return Options::get().all;
+}
+
+double benchmark(string const& _what, function<void()> const& _func)
+{
+    Timer timer;
+    _func();
+    double const seconds = timer.elapsed();
+    ETH_STDOUT_MESSAGE(_what + ": " + toString(seconds) + "s");
+    return seconds;
+}
+
+void forEachSupportedKernel(
+    vector<SimdKernel> const& _kernels, function<void(SimdKernel)> const& _func, bool _reportSkipped)
+{
+    for (SimdKernel kernel : _kernels)
+    {
+        if (simdKernelSupported(kernel))
+            _func(kernel);
+        else if (_reportSkipped)
+            ETH_STDOUT_MESSAGE("Kernel is not supported by the CPU: " + simdKernelName(kernel));
+    }
+}
+
+}  // namespace test
@@ -0,0 +1,40 @@
+/*
+    This file is part of cpp-ethereum.
+
+    cpp-ethereum is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    cpp-ethereum is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with cpp-ethereum.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file unitTestHelper.h
+ * Helpers shared by the unit tests of the SIMD kernels and by the benchmarks.
+ */
+
+#pragma once
+#include <libdevcore/CpuFeatures.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace test
+{
+// Benchmark test cases run only with --all
+bool benchmarksEnabled();
+
+// Run _func timed with dev::Timer, print "<_what>: <seconds>s" and return the seconds
+double benchmark(std::string const& _what, std::function<void()> const& _func);
+
+// Call _func for each of _kernels supported by the CPU. Kernels the CPU does not support are
+// skipped, with a message when _reportSkipped is set
+void forEachSupportedKernel(std::vector<dev::SimdKernel> const& _kernels,
+    std::function<void(dev::SimdKernel)> const& _func, bool _reportSkipped = true);
+
+}  // namespace test
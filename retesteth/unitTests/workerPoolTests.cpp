@@ -0,0 +1,339 @@
+/*
+    This file is part of cpp-ethereum.
+
+    cpp-ethereum is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    cpp-ethereum is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with cpp-ethereum.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file workerPoolTests.cpp
+ * Unit tests for the test scheduler worker pool.
+ */
+
+#include <retesteth/Options.h>
+#include <retesteth/TestOutputHelper.h>
+#include <retesteth/WorkerPool.h>
+#include <retesteth/session/RPCSession.h>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <set>
+
+using namespace std;
+using namespace dev;
+using namespace test;
+
+namespace
+{
+// Imitates RPCSession socket map: a session per thread id with its status
+class MockSessionMap
+{
+public:
+    void start(size_t _threadID)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_sessions[_threadID] = RPCSession::Working;
+    }
+    void end(size_t _threadID, RPCSession::SessionStatus _status)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_sessions[_threadID] = _status;
+    }
+    RPCSession::SessionStatus status(size_t _threadID)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_sessions.count(_threadID))
+            return m_sessions.at(_threadID);
+        return RPCSession::NotExist;
+    }
+    size_t sessionCount()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_sessions.size();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::map<size_t, RPCSession::SessionStatus> m_sessions;
+};
+
+void mockTest(MockSessionMap& _sessions, std::chrono::milliseconds _duration)
+{
+    size_t const id = TestOutputHelper::getThreadID();
+    _sessions.start(id);
+    std::this_thread::sleep_for(_duration);
+    _sessions.end(id, RPCSession::HasFinished);
+}
+
+// Thread per test with a busy wait on session status as TestSuite did before the pool
+void runThreadPerTest(MockSessionMap& _sessions, size_t _tests, size_t _threads,
+    std::chrono::milliseconds _duration)
+{
+    // test thread and its id, 0 until the thread has started
+    typedef std::pair<thread, std::shared_ptr<std::atomic<size_t>>> TestThread;
+    vector<TestThread> threadVector;
+    for (size_t i = 0; i < _tests; i++)
+    {
+        if (threadVector.size() == _threads)
+        {
+            bool finished = false;
+            while (!finished)
+            {
+                for (auto it = threadVector.begin(); it != threadVector.end(); it++)
+                {
+                    size_t const id = *it->second;
+                    finished = id != 0 && _sessions.status(id) == RPCSession::HasFinished;
+                    if (finished)
+                    {
+                        it->first.join();
+                        _sessions.end(id, RPCSession::Available);
+                        threadVector.erase(it);
+                        break;
+                    }
+                }
+            }
+        }
+        std::shared_ptr<std::atomic<size_t>> id = std::make_shared<std::atomic<size_t>>(0);
+        thread th([&_sessions, _duration, id]() {
+            mockTest(_sessions, _duration);
+            *id = TestOutputHelper::getThreadID();
+        });
+        threadVector.push_back(TestThread(std::move(th), id));
+    }
+    for (auto& th : threadVector)
+        th.first.join();
+}
+
+void runWorkerPool(MockSessionMap& _sessions, size_t _tests, size_t _threads,
+    std::chrono::milliseconds _duration)
+{
+    WorkerPool pool(_threads);
+    for (size_t i = 0; i < _tests; i++)
+        pool.addTask([&_sessions, _duration]() { mockTest(_sessions, _duration); });
+    pool.wait();
+}
+
+// Process cpu time in seconds spent by _func
+double cpuTime(std::function<void()> const& _func)
+{
+    std::clock_t const start = std::clock();
+    _func();
+    return double(std::clock() - start) / CLOCKS_PER_SEC;
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(WorkerPoolSuite, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(workerPool_executeAllTasks)
+{
+    std::atomic<size_t> executed(0);
+    std::atomic<size_t> running(0);
+    std::atomic<size_t> maxRunning(0);
+    size_t reported = 0;
+    {
+        WorkerPool pool(3);
+        BOOST_CHECK(pool.threadCount() == 3);
+        for (size_t i = 0; i < 20; i++)
+            pool.addTask([&]() {
+                size_t const nowRunning = ++running;
+                size_t prevMax = maxRunning;
+                while (nowRunning > prevMax && !maxRunning.compare_exchange_weak(prevMax, nowRunning))
+                {
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                running--;
+                executed++;
+            });
+        pool.wait([&reported]() { reported++; });
+    }
+    BOOST_CHECK(executed == 20);
+    BOOST_CHECK(reported == 20);
+    BOOST_CHECK(maxRunning <= 3);
+}
+
+BOOST_AUTO_TEST_CASE(workerPool_backgroundTasksNotReported)
+{
+    std::atomic<size_t> executed(0);
+    size_t reported = 0;
+    {
+        WorkerPool pool(2);
+        for (size_t i = 0; i < 10; i++)
+        {
+            pool.addTask([&executed]() { executed++; }, false);
+            pool.addTask([&executed]() { executed++; });
+        }
+        pool.wait([&reported]() { reported++; });
+    }
+
+    // wait() returns after background tasks too, but reports only the others
+    BOOST_CHECK(executed == 20);
+    BOOST_CHECK(reported == 10);
+}
+
+BOOST_AUTO_TEST_CASE(workerPool_workerBoundToSession)
+{
+    MockSessionMap sessions;
+    std::mutex idsMutex;
+    std::set<size_t> taskThreads;
+    std::atomic<size_t> exitedWorkers(0);
+    {
+        WorkerPool pool(2, std::function<void()>(), [&sessions, &exitedWorkers]() {
+            sessions.end(TestOutputHelper::getThreadID(), RPCSession::Available);
+            exitedWorkers++;
+        });
+        for (size_t i = 0; i < 10; i++)
+            pool.addTask([&]() {
+                mockTest(sessions, std::chrono::milliseconds(1));
+                std::lock_guard<std::mutex> lock(idsMutex);
+                taskThreads.insert(TestOutputHelper::getThreadID());
+            });
+        pool.wait();
+    }
+
+    // Tasks are executed only by the pool threads, one session per worker
+    BOOST_CHECK(taskThreads.size() <= 2);
+    BOOST_CHECK(sessions.sessionCount() == taskThreads.size());
+    BOOST_CHECK(exitedWorkers == 2);
+    for (auto const& id : taskThreads)
+        BOOST_CHECK(sessions.status(id) == RPCSession::Available);
+}
+
+BOOST_AUTO_TEST_CASE(threadIDsNotReused)
+{
+    std::set<size_t> ids;
+    for (size_t i = 0; i < 5; i++)
+    {
+        size_t id = 0;
+        thread th([&id]() { id = TestOutputHelper::getThreadID(); });
+        th.join();
+        ids.insert(id);
+    }
+    BOOST_CHECK(ids.size() == 5);
+    BOOST_CHECK(ids.count(TestOutputHelper::getThreadID()) == 0);
+    BOOST_CHECK(TestOutputHelper::getThreadID() == TestOutputHelper::getThreadID());
+}
+
+BOOST_AUTO_TEST_CASE(workerPool_cancel)
+{
+    std::atomic<size_t> executed(0);
+    WorkerPool pool(1);
+    for (size_t i = 0; i < 50; i++)
+        pool.addTask([&executed]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            executed++;
+        });
+    pool.wait([&pool]() { pool.cancel(); });
+    BOOST_CHECK(executed < 50);
+    BOOST_CHECK(executed > 0);
+}
+
+BOOST_AUTO_TEST_CASE(workerPool_rethrowTaskException)
+{
+    std::atomic<size_t> executed(0);
+    WorkerPool pool(2);
+    pool.addTask([]() { throw std::runtime_error("task failed"); });
+    for (size_t i = 0; i < 5; i++)
+        pool.addTask([&executed]() { executed++; });
+    BOOST_CHECK_THROW(pool.wait(), std::runtime_error);
+    BOOST_CHECK(executed == 5);
+
+    // the pool is still usable after the exception
+    pool.addTask([&executed]() { executed++; });
+    pool.wait();
+    BOOST_CHECK(executed == 6);
+}
+
+BOOST_AUTO_TEST_CASE(workerPool_runTaskGroup)
+{
+    std::mutex idsMutex;
+    std::set<size_t> unitThreads;
+    vector<size_t> results(16, 0);
+    size_t reported = 0;
+    std::atomic<bool> isPoolTask(false);
+    {
+        WorkerPool pool(4);
+        pool.addTask([&]() {
+            isPoolTask = WorkerPool::current() == &pool;
+            vector<std::function<void()>> units;
+            for (size_t i = 0; i < results.size(); i++)
+                units.push_back([&, i]() {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                    results.at(i) = i + 1;
+                    std::lock_guard<std::mutex> lock(idsMutex);
+                    unitThreads.insert(TestOutputHelper::getThreadID());
+                });
+            WorkerPool::current()->runTaskGroup(units);
+        });
+        pool.wait([&reported]() { reported++; });
+    }
+
+    // group helpers are not reported as finished tasks
+    BOOST_CHECK(isPoolTask);
+    BOOST_CHECK(reported == 1);
+    BOOST_CHECK(unitThreads.size() > 1);
+    BOOST_CHECK(WorkerPool::current() == nullptr);
+    for (size_t i = 0; i < results.size(); i++)
+        BOOST_CHECK(results.at(i) == i + 1);
+}
+
+BOOST_AUTO_TEST_CASE(workerPool_runTaskGroupException)
+{
+    std::atomic<size_t> executed(0);
+    std::atomic<bool> rethrown(false);
+    WorkerPool pool(3);
+    pool.addTask([&executed, &rethrown]() {
+        vector<std::function<void()>> units;
+        units.push_back([]() { throw std::runtime_error("unit failed"); });
+        for (size_t i = 0; i < 5; i++)
+            units.push_back([&executed]() { executed++; });
+        try
+        {
+            WorkerPool::current()->runTaskGroup(units);
+        }
+        catch (std::runtime_error const&)
+        {
+            rethrown = true;
+        }
+    });
+    pool.wait();
+    BOOST_CHECK(rethrown);
+    BOOST_CHECK(executed == 5);
+}
+
+// Waiting for the mock sessions should not consume cpu time
+BOOST_AUTO_TEST_CASE(workerPool_idleWaitBenchmark)
+{
+    if (!test::Options::get().all)
+        return;
+
+    size_t const tests = 40;
+    size_t const threads = 4;
+    std::chrono::milliseconds const duration(50);
+    double const wallTime = double(tests / threads * duration.count()) / 1000;
+
+    MockSessionMap busySessions;
+    double const busyWaitCpu =
+        cpuTime([&]() { runThreadPerTest(busySessions, tests, threads, duration); });
+    MockSessionMap poolSessions;
+    double const poolCpu = cpuTime([&]() { runWorkerPool(poolSessions, tests, threads, duration); });
+
+    ETH_STDOUT_MESSAGE("Scheduler idle wait cpu time (wall time " + toString(wallTime) +
+                       "s): thread per test " + toString(busyWaitCpu) + "s, worker pool " +
+                       toString(poolCpu) + "s");
+    BOOST_CHECK(poolCpu < wallTime * 0.1);
+    BOOST_CHECK(poolCpu < busyWaitCpu);
+    BOOST_CHECK(poolSessions.sessionCount() <= threads);
+}
+
+BOOST_AUTO_TEST_SUITE_END()